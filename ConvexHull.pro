@@ -3,6 +3,8 @@ TEMPLATE = app
 TARGET = ConvexHull
 
 QT += opengl
+CONFIG += c++11
+greaterThan(QT_MAJOR_VERSION, 4): QT += concurrent
 
 DEPENDPATH += . dcel
 INCLUDEPATH += . dcel
@@ -14,7 +16,23 @@ HEADERS +=  \
             dcel/structures.hh \
     timer.h \
     conflict_node.h \
-    conflict_graph.h
+    conflict_graph.h \
+    hull_algorithm.h \
+    incremental_hull.h \
+    online_hull.h \
+    quickhull.h \
+    divide_conquer_hull.h \
+    chan_hull.h \
+    group_hull.h \
+    dynamic_hull.h \
+    small_hull.h \
+    batch_hull.h \
+    interior_culling.h \
+    duplicate_removal.h \
+    epsilon_kernel.h \
+    predicates.h \
+    point_block.h \
+    edge_index.h
 
 SOURCES +=  \
             engine.cpp \
@@ -22,7 +40,23 @@ SOURCES +=  \
             window_gl.cpp \
             dcel/DCEL.cpp \
     conflict_node.cpp \
-    conflict_graph.cpp
+    conflict_graph.cpp \
+    hull_algorithm.cpp \
+    incremental_hull.cpp \
+    online_hull.cpp \
+    quickhull.cpp \
+    divide_conquer_hull.cpp \
+    chan_hull.cpp \
+    group_hull.cpp \
+    dynamic_hull.cpp \
+    small_hull.cpp \
+    batch_hull.cpp \
+    interior_culling.cpp \
+    duplicate_removal.cpp \
+    epsilon_kernel.cpp \
+    predicates.cpp \
+    point_block.cpp \
+    edge_index.cpp
 
 OTHER_FILES +=
 
@@ -0,0 +1,95 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "batch_hull.h"
+#include <algorithm>
+#include <QThread>
+#include <QtConcurrentMap>
+
+int batch_hull::calculate(const QVector< QVector<vertex> > &point_sets, QVector<DCEL> &hulls)
+{
+    hulls.clear();
+    hulls.resize(point_sets.size());
+    
+    QAtomicInt next_set(0);
+    QVector<batch_worker> workers(QThread::idealThreadCount());
+    
+    for (int i = 0; i < workers.size(); i++) {
+        
+        workers[i].point_sets = point_sets.constData();
+        workers[i].hulls = hulls.data();
+        workers[i].sets_n = point_sets.size();
+        workers[i].next_set = &next_set;
+        workers[i].computed = 0;
+    }
+    
+    QtConcurrent::blockingMap(workers, run_worker);
+    
+    int computed = 0;
+    
+    for (int i = 0; i < workers.size(); i++) {
+        
+        computed += workers[i].computed;
+    }
+    
+    return computed;
+}
+
+// Take the sets a few at a time, so the workers which get the larger sets take fewer of them.
+// Each set is passed by const reference to the algorithm, which only reads it, so its points are never copied.
+void batch_hull::run_worker(batch_worker &worker)
+{
+    for (;;) {
+        
+        int first = worker.next_set->fetchAndAddOrdered(BATCH_SETS_PER_TAKE);
+        
+        if (first >= worker.sets_n) {
+            
+            return;
+        }
+        
+        int last = std::min(first + BATCH_SETS_PER_TAKE, worker.sets_n);
+        
+        for (int i = first; i < last; i++) {
+            
+            const QVector<vertex> &points = worker.point_sets[i];
+            DCEL &convex_hull = worker.hulls[i];
+            
+            bool computed;
+            
+            if (points.size() <= SMALL_HULL_POINTS) {
+                
+                computed = worker.small.calculate(points, convex_hull);
+            } else {
+                
+                computed = worker.large.calculate(points, convex_hull);
+            }
+            
+            if (computed) {
+                
+                convex_hull.compact();
+                worker.computed++;
+            } else {
+                
+                convex_hull.reset();
+            }
+        }
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BATCH_HULL_H
+#define BATCH_HULL_H
+
+#include <QVector>
+#include <QAtomicInt>
+#include "dcel/DCEL.hh"
+#include "quickhull.h"
+#include "small_hull.h"
+
+// Sets of points taken at once by a worker of the batch computation
+#define BATCH_SETS_PER_TAKE 16
+
+// Worker of the batch computation: it takes the next sets of points to process until none is left, and keeps its
+// algorithms between the sets, so their scratch lists are allocated once per worker instead of once per set.
+struct batch_worker
+{
+    const QVector<vertex> *point_sets;
+    DCEL *hulls;
+    int sets_n;
+    
+    // Next set to take, shared by all the workers
+    QAtomicInt *next_set;
+    
+    // Convex hulls computed by the worker
+    int computed;
+    
+    quickhull large;
+    small_hull small;
+};
+
+// Convex hulls of many small sets of points, computed in parallel with one worker per thread. The sets up to
+// SMALL_HULL_POINTS points take the small_hull path, the others are computed with Quickhull: both are deterministic,
+// so the workers don't share the random number generator as the incremental algorithm would.
+class batch_hull
+{
+    public:
+        
+        // Compute the convex hull of each set of "point_sets" into the same position of "hulls", with only the faces,
+        // half-edges and vertexes on the convex hull. The sets whose points don't span a volume get an empty DCEL.
+        // Return the number of convex hulls computed.
+        int calculate(const QVector< QVector<vertex> > &point_sets, QVector<DCEL> &hulls);
+        
+    private:
+        
+        static void run_worker(batch_worker &worker);
+};
+
+#endif // BATCH_HULL_H
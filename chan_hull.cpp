@@ -0,0 +1,255 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "chan_hull.h"
+#include <QtConcurrentMap>
+#include "quickhull.h"
+#include "point_block.h"
+#include "predicates.h"
+#include <cmath>
+#include <algorithm>
+
+bool chan_hull::calculate(QVector<vertex> &vertex_list, DCEL &convex_hull)
+{
+    // Only the vertexes of the group hulls of a guess can be on the convex hull, so they are the points of the next guess
+    QVector<vertex> candidates = vertex_list;
+    
+    max_coordinate = 0;
+    
+    for (int i = 0; i < vertex_list.size(); i++) {
+        
+        const CGPointf &point = vertex_list.at(i).coord;
+        
+        max_coordinate = std::max(max_coordinate, (double)std::max(std::fabs(point.x), std::max(std::fabs(point.y), std::fabs(point.z))));
+    }
+    
+    for (qint64 group_size = CHAN_FIRST_GROUP; ; group_size *= group_size) {
+        
+        // Drop the convex hull of the last failed guess
+        convex_hull.reset();
+        
+        // A single group is the whole convex hull
+        if (group_size >= candidates.size()) {
+            
+            quickhull hull;
+            
+            return hull.calculate(candidates, convex_hull);
+        }
+        
+        QVector<group_hull> groups((candidates.size() + group_size - 1) / group_size);
+        
+        for (int i = 0; i < groups.size(); i++) {
+            
+            groups[i].vertexes = candidates.mid(i * group_size, group_size);
+        }
+        
+        QtConcurrent::blockingMap(groups, build_group_hull);
+        
+        if (wrap(candidates, groups, group_size, convex_hull)) {
+            
+            return true;
+        }
+        
+        // The points don't span a volume
+        if (convex_hull.get_vertex_n() == 0) {
+            
+            return false;
+        }
+        
+        candidates.clear();
+        
+        for (int i = 0; i < groups.size(); i++) {
+            
+            candidates += groups[i].vertexes;
+        }
+    }
+}
+
+// Grow the convex hull from the extreme tethraedron, inserting the farthest point above each face until no point is above
+// any face. Return false if the convex hull gets more than "max_vertexes" vertexes, or if the points don't span a volume
+// (then "convex_hull" is left empty).
+bool chan_hull::wrap(QVector<vertex> &vertex_list, QVector<group_hull> &groups, int max_vertexes, DCEL &convex_hull)
+{
+    int p0, p1, p2, p3;
+    
+    if (!find_extreme_tethraedron(vertex_list, p0, p1, p2, p3)) {
+        
+        return false;
+    }
+    
+    double orientation = orient3d(vertex_list[p0].coord, vertex_list[p1].coord, vertex_list[p2].coord, vertex_list[p3].coord);
+    
+    if (orientation == 0) {
+        
+        return false;
+    }
+    
+    int v0 = convex_hull.add_vertex(vertex_list[p0]);
+    int v1 = convex_hull.add_vertex(vertex_list[p1]);
+    int v2 = convex_hull.add_vertex(vertex_list[p2]);
+    int v3 = convex_hull.add_vertex(vertex_list[p3]);
+    
+    // As in the other algorithms, the faces have to be in clockwise sense from outside
+    if (orientation > 0) {
+        
+        create_tethraedron(convex_hull, v0, v2, v1, v3);
+    } else {
+        
+        create_tethraedron(convex_hull, v0, v1, v2, v3);
+    }
+    
+    QVector<int> pending_faces;
+    
+    for (int i = 0; i < convex_hull.get_faces_n(); i++) {
+        
+        pending_faces.append(i);
+    }
+    
+    int vertexes_n = STARTING_POINTS;
+    
+    // Distance of the farthest point of each group above the face being checked
+    QVector<double> group_distances(groups.size());
+    
+    while (!pending_faces.isEmpty()) {
+        
+        int face_id = pending_faces.takeLast();
+        
+        // Skip the faces removed from the convex hull after they were queued
+        if (!convex_hull.is_face_in_convex_hull(face_id)) {
+            
+            continue;
+        }
+        
+        const face_plane &plane = convex_hull.get_face_plane(face_id);
+        
+        // The farthest point above the face is the farthest of the extreme points of the groups
+        int eye_group = -1;
+        int eye = -1;
+        double eye_distance = 0;
+        
+        for (int i = 0; i < groups.size(); i++) {
+            
+            double distance;
+            int extreme = extreme_vertex(groups[i], plane.normal, plane.origin, distance);
+            
+            group_distances[i] = distance;
+            
+            if (eye_group == -1 || distance > eye_distance) {
+                
+                eye_group = i;
+                eye = extreme;
+                eye_distance = distance;
+            }
+        }
+        
+        // Bound of the rounding error of the distances, with both the point and the origin within max_coordinate
+        double margin = CHAN_ERROR_BOUND * (std::fabs(plane.normal[0]) + std::fabs(plane.normal[1]) + std::fabs(plane.normal[2])) * 2 * max_coordinate;
+        
+        // The farthest point is only reliable far from the face: near it, the groups whose farthest point is within the
+        // error are scanned with the exact test, so the face is never accepted with a point above it
+        if (plane_distance(plane, groups[eye_group].vertexes[eye].coord) <= 0 && eye_distance > -margin) {
+            
+            eye_group = -1;
+            
+            for (int i = 0; i < groups.size(); i++) {
+                
+                if (group_distances[i] <= -margin) {
+                    
+                    continue;
+                }
+                
+                double distance;
+                int above = farthest_above(groups[i], plane, distance);
+                
+                if (above != -1 && (eye_group == -1 || distance > eye_distance)) {
+                    
+                    eye_group = i;
+                    eye = above;
+                    eye_distance = distance;
+                }
+            }
+            
+            // No point is above the face
+            if (eye_group == -1) {
+                
+                continue;
+            }
+        }
+        
+        vertex point = groups[eye_group].vertexes[eye];
+        
+        // The face is on the final convex hull
+        if (plane_distance(plane, point.coord) <= 0) {
+            
+            continue;
+        }
+        
+        QVector<int> visible_faces;
+        QVector<int> horizon_edges;
+        QVector<int> edges_to_set_twin;
+        
+        find_visible_faces(convex_hull, face_id, point, visible_faces);
+        
+        int new_vertex = convex_hull.add_vertex(point);
+        
+        find_horizon(convex_hull, visible_faces, horizon_edges);
+        
+        // The visible region is a triangulated disk, so it has (F - H + 2) / 2 vertexes inside its horizon of H edges,
+        // which leave the convex hull while the new vertex joins it
+        vertexes_n += 1 - (visible_faces.size() - horizon_edges.size() + 2) / 2;
+        
+        // The guess of the number of vertexes was too small
+        if (vertexes_n > max_vertexes) {
+            
+            return false;
+        }
+        
+        hide_visible_region(convex_hull, visible_faces, horizon_edges);
+        
+        for (int i = 0; i < horizon_edges.size(); i++) {
+            
+            pending_faces.append(create_cone_face(convex_hull, horizon_edges[i], new_vertex, edges_to_set_twin));
+        }
+        
+        set_correct_twin(convex_hull, edges_to_set_twin);
+    }
+    
+    return true;
+}
+
+// Return the vertex of the group farthest above the plane with the exact test, with its distance in "distance", or -1 if no
+// vertex is above it.
+int chan_hull::farthest_above(const group_hull &group, const face_plane &plane, double &distance)
+{
+    int farthest = -1;
+    
+    for (int i = 0; i < group.vertexes.size(); i++) {
+        
+        double candidate_distance = plane_distance(plane, group.vertexes.at(i).coord);
+        
+        if (candidate_distance > 0 && (farthest == -1 || candidate_distance > distance)) {
+            
+            farthest = i;
+            distance = candidate_distance;
+        }
+    }
+    
+    return farthest;
+}
@@ -0,0 +1,57 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHAN_HULL_H
+#define CHAN_HULL_H
+
+#include "hull_algorithm.h"
+#include "group_hull.h"
+#include <cfloat>
+
+// Size of the groups of the first guess, 2^(2^3): smaller groups cost more to build than they save. Each failed guess squares it.
+#define CHAN_FIRST_GROUP 256
+
+// Relative error bound of the dot products of the extreme point queries
+#define CHAN_ERROR_BOUND (8 * DBL_EPSILON)
+
+// Output sensitive algorithm in the style of Chan: the points are split in groups of m points, whose convex hulls are
+// computed in parallel. The convex hull is then grown as in Quickhull, but the farthest point above a face is found with
+// an extreme point query on each group, walking its convex hull towards the normal of the face. If the convex hull gets
+// more than m vertexes, m is squared and the groups are built again from the vertexes of the old group hulls, so the cost
+// is O(n log h) for h vertexes on the convex hull. The queries compare floating point dot products, so when the farthest
+// point of a group is within their rounding error of a face, the group is scanned with the exact test before the face is
+// accepted.
+class chan_hull : public hull_algorithm
+{
+    public:
+        
+        bool calculate(QVector<vertex> &vertex_list, DCEL &convex_hull);
+        
+    private:
+        
+        bool wrap(QVector<vertex> &vertex_list, QVector<group_hull> &groups, int max_vertexes, DCEL &convex_hull);
+        
+        int farthest_above(const group_hull &group, const face_plane &plane, double &distance);
+        
+        // Largest absolute coordinate of the points, to bound the rounding errors of the queries
+        double max_coordinate;
+};
+
+#endif // CHAN_HULL_H
@@ -20,67 +20,237 @@
 
 #include "conflict_graph.h"
 
+conflict_iterator::conflict_iterator(const QVector<conflict_arch> &arches, const QVector<conflict_node> &nodes, int first_arch, bool faces)
+{
+    this->arches = arches.constData();
+    this->nodes = nodes.constData();
+    this->arch = first_arch;
+    this->faces = faces;
+    
+    skip_stale();
+}
+
+bool conflict_iterator::has_next() const
+{
+    return arch != -1;
+}
+
+// Return the next face or vertex, and move to the following arch of the list which isn't stale.
+int conflict_iterator::next()
+{
+    const conflict_arch &current = arches[arch];
+    
+    if (faces) {
+        
+        arch = current.next_in_vertex;
+        skip_stale();
+        
+        return current.face_id;
+    }
+    
+    arch = current.next_in_face;
+    skip_stale();
+    
+    return current.vertex_id;
+}
+
+// Move forward while the node at the other end of the arch has been removed.
+void conflict_iterator::skip_stale(void)
+{
+    if (faces) {
+        
+        while (arch != -1 && nodes[arches[arch].face_id].removed) {
+            
+            arch = arches[arch].next_in_vertex;
+        }
+    } else {
+        
+        while (arch != -1 && nodes[arches[arch].vertex_id].removed) {
+            
+            arch = arches[arch].next_in_face;
+        }
+    }
+}
+
 conflict_graph::conflict_graph()
 {
-    conflict_node null_node(-1);
+    stale_arches = 0;
     
-    // Fill f_conflict with four null nodes. In this way, we can access directly f_conflict with the id of the vertex in the convex hull.
-    f_conflict.fill(null_node, 4);
+    // Fill f_conflict with four empty nodes. In this way, we can access directly f_conflict with the id of the vertex in the convex hull.
+    f_conflict.resize(4);
 }
 
 // Add a face node to the conflict graph.
 void conflict_graph::add_face_node(int face_id)
 {
-    conflict_node new_node(face_id);
-    
-    p_conflict.append(new_node);
+    if (face_id >= p_conflict.size()) {
+        
+        p_conflict.resize(face_id + 1);
+    }
 }
 
 // Add a vertex node to the conflict graph.
 void conflict_graph::add_vertex_node(int vertex_id)
 {
-    conflict_node new_node(vertex_id);
-    
-    f_conflict.append(new_node);
+    if (vertex_id >= f_conflict.size()) {
+        
+        f_conflict.resize(vertex_id + 1);
+    }
 }
 
-// Create an arch between a face node and a vertex node.
+// Create an arch between a face node and a vertex node, appending it to both their lists.
 void conflict_graph::create_arch(int face_id, int vertex_id)
 {
-    f_conflict[vertex_id].add_arch(face_id);
-    p_conflict[face_id].add_arch(vertex_id);
+    int arch = arches.size();
+    arches.resize(arch + 1);
+    
+    arches[arch].face_id = face_id;
+    arches[arch].vertex_id = vertex_id;
+    
+    append_arch(arch);
+}
+
+// Append an arch to the end of the list of its face and of the list of its vertex.
+void conflict_graph::append_arch(int arch)
+{
+    conflict_arch &new_arch = arches[arch];
+    conflict_node &face_node = p_conflict[new_arch.face_id];
+    conflict_node &vertex_node = f_conflict[new_arch.vertex_id];
+    
+    new_arch.next_in_face = -1;
+    new_arch.next_in_vertex = -1;
+    
+    if (face_node.last_arch != -1) {
+        
+        arches[face_node.last_arch].next_in_face = arch;
+    } else {
+        
+        face_node.first_arch = arch;
+    }
+    
+    face_node.last_arch = arch;
+    face_node.arches_n++;
+    
+    if (vertex_node.last_arch != -1) {
+        
+        arches[vertex_node.last_arch].next_in_vertex = arch;
+    } else {
+        
+        vertex_node.first_arch = arch;
+    }
+    
+    vertex_node.last_arch = arch;
+    vertex_node.arches_n++;
 }
 
 // Get all the faces visible from the "vertex_id" vertex.
 QVector<int> conflict_graph::get_visible_faces(int vertex_id)
 {
-    return f_conflict[vertex_id].get_arch_list();
+    QVector<int> face_list;
+    
+    for (conflict_iterator face = visible_faces(vertex_id); face.has_next(); ) {
+        
+        face_list.append(face.next());
+    }
+    
+    return face_list;
 }
 
 // Get all the vertexes which can see the "face_id" face.
 QVector<int> conflict_graph::get_visible_vertexes(int face_id)
 {
-    return p_conflict[face_id].get_arch_list();
+    QVector<int> vertex_list;
+    
+    for (conflict_iterator vertex = visible_vertexes(face_id); vertex.has_next(); ) {
+        
+        vertex_list.append(vertex.next());
+    }
+    
+    return vertex_list;
+}
+
+conflict_iterator conflict_graph::visible_faces(int vertex_id) const
+{
+    return conflict_iterator(arches, p_conflict, f_conflict.at(vertex_id).first_arch, true);
+}
+
+conflict_iterator conflict_graph::visible_vertexes(int face_id) const
+{
+    return conflict_iterator(arches, f_conflict, p_conflict.at(face_id).first_arch, false);
+}
+
+bool conflict_graph::has_visible_faces(int vertex_id) const
+{
+    return visible_faces(vertex_id).has_next();
 }
 
-// Delete all arches with the face to delete.
+// Mark the face as removed: its arches become stale.
 void conflict_graph::remove_face_node(int face_id)
 {
-    QVector<int> vertex_list = p_conflict[face_id].get_arch_list();
+    conflict_node &face_node = p_conflict[face_id];
     
-    for (int i = 0; i < vertex_list.size(); i++) {
+    if (!face_node.removed) {
         
-        f_conflict[vertex_list[i]].remove_arch(face_id);
+        face_node.removed = true;
+        stale_arches += face_node.arches_n;
+    }
+    
+    if (stale_arches > arches.size() * STALE_ARCHES_RATIO) {
+        
+        compact();
     }
 }
 
-// Delete all arches with the vertex to delete.
+// Mark the vertex as removed: its arches become stale.
 void conflict_graph::remove_vertex_node(int vertex_id)
 {
-    QVector<int> face_list = f_conflict[vertex_id].get_arch_list();
+    conflict_node &vertex_node = f_conflict[vertex_id];
+    
+    if (!vertex_node.removed) {
+        
+        vertex_node.removed = true;
+        stale_arches += vertex_node.arches_n;
+    }
+    
+    if (stale_arches > arches.size() * STALE_ARCHES_RATIO) {
+        
+        compact();
+    }
+}
+
+// Drop the stale arches in a single pass over the pool. The arches left keep their order, in the pool and in every list, and
+// the lists of the removed nodes become empty.
+void conflict_graph::compact(void)
+{
+    int arches_n = 0;
+    
+    for (int i = 0; i < p_conflict.size(); i++) {
+        
+        p_conflict[i].first_arch = -1;
+        p_conflict[i].last_arch = -1;
+        p_conflict[i].arches_n = 0;
+    }
     
-    for (int i = 0; i < face_list.size(); i++) {
+    for (int i = 0; i < f_conflict.size(); i++) {
         
-        p_conflict[face_list[i]].remove_arch(vertex_id);
+        f_conflict[i].first_arch = -1;
+        f_conflict[i].last_arch = -1;
+        f_conflict[i].arches_n = 0;
     }
+    
+    // Move the arches left to the front of the pool and link them again. The lists followed the order of the pool, so
+    // appending the arches in that order rebuilds the same lists.
+    for (int i = 0; i < arches.size(); i++) {
+        
+        if (p_conflict[arches[i].face_id].removed || f_conflict[arches[i].vertex_id].removed) {
+            
+            continue;
+        }
+        
+        arches[arches_n] = arches[i];
+        append_arch(arches_n++);
+    }
+    
+    arches.resize(arches_n);
+    stale_arches = 0;
 }
@@ -21,8 +21,37 @@
 #ifndef CONFLICT_GRAPH_H
 #define CONFLICT_GRAPH_H
 
+#include <QVector>
 #include "conflict_node.h"
 
+// Fraction of stale arches in the pool over which the conflict graph is compacted
+#define STALE_ARCHES_RATIO 0.5
+
+// Iterator over the faces visible from a vertex, or the vertexes which can see a face. It reads the arches in place, without
+// copying them, and skips the stale ones, so the conflict graph mustn't change while it is used.
+class conflict_iterator
+{
+    public:
+        
+        conflict_iterator(const QVector<conflict_arch> &arches, const QVector<conflict_node> &nodes, int first_arch, bool faces);
+        
+        bool has_next() const;
+        int next();
+        
+    private:
+        
+        void skip_stale(void);
+        
+        const conflict_arch *arches;
+        const conflict_node *nodes;
+        int arch;
+        bool faces;
+};
+
+// Bipartite conflict graph between the faces of the convex hull and the vertexes not yet inserted. The arches are kept in a
+// pool, and each of them is linked both in the list of its face and in the list of its vertex. Creating an arch costs O(1), and
+// so does removing a node: it is only marked as removed, and its arches become stale. The stale arches are skipped while
+// reading, and they are dropped all together when they are more than STALE_ARCHES_RATIO of the pool.
 class conflict_graph
 {
     public:
@@ -32,18 +61,32 @@ class conflict_graph
         void add_face_node(int face_id);
         void add_vertex_node(int vertex_id);
         
+        // Create an arch between a face and a vertex, which mustn't be already joined
         void create_arch(int face_id, int vertex_id);
         
         QVector<int> get_visible_faces(int vertex_id);
         QVector<int> get_visible_vertexes(int face_id);
         
+        conflict_iterator visible_faces(int vertex_id) const;
+        conflict_iterator visible_vertexes(int face_id) const;
+        
+        bool has_visible_faces(int vertex_id) const;
+        
         void remove_face_node(int face_id);
         void remove_vertex_node(int vertex_id);
         
     private:
         
+        void append_arch(int arch);
+        void compact(void);
+        
         QVector<conflict_node> f_conflict;
         QVector<conflict_node> p_conflict;
+        
+        QVector<conflict_arch> arches;
+        
+        // Arches of the removed nodes. An arch with both its nodes removed is counted twice, so this is an upper bound.
+        int stale_arches;
 };
 
 #endif // CONFLICT_GRAPH_H
@@ -22,35 +22,8 @@
 
 conflict_node::conflict_node()
 {
-}
-
-conflict_node::conflict_node(int node_id)
-{
-    // Set the id of the node
-    this->node_id = node_id;
-}
-
-// Add an arch with a certain node with "node_id" id.
-void conflict_node::add_arch(int node_id)
-{
-    if (!arch_list.contains(node_id)) {
-        
-        arch_list.append(node_id);
-    }
-}
-
-QVector<int> conflict_node::get_arch_list()
-{
-    return arch_list;
-}
-
-// Remove an arch between two nodes.
-void conflict_node::remove_arch(int node_id)
-{
-    int position = arch_list.indexOf(node_id);
-    
-    if (position != -1) {
-        
-        arch_list.remove(position);
-    }
+    first_arch = -1;
+    last_arch = -1;
+    arches_n = 0;
+    removed = false;
 }
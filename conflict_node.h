@@ -21,23 +21,27 @@
 #ifndef CONFLICT_NODE_H
 #define CONFLICT_NODE_H
 
-#include <QVector>
+// Arch of the conflict graph between a face and a vertex which can see it. Each arch is in two linked lists: the list of the
+// arches of its face and the list of the arches of its vertex. It is stale when its face or its vertex has been removed.
+struct conflict_arch
+{
+    int face_id;
+    int vertex_id;
+    
+    int next_in_face;
+    int next_in_vertex;
+};
 
-class conflict_node
+// Node of the conflict graph, for a face or a vertex: the first and the last arch of its list, -1 if it has no arch, and the
+// number of arches created with it. A removed node is only marked, and its arches are skipped until the graph is compacted.
+struct conflict_node
 {
-    public:
-        
-        conflict_node();
-        conflict_node(int node_id);
-        
-        void add_arch(int node_id);
-        QVector<int> get_arch_list();
-        void remove_arch(int node_id);
-        
-    private:
-        
-        int node_id;
-        QVector<int> arch_list;
+    conflict_node();
+    
+    int first_arch;
+    int last_arch;
+    int arches_n;
+    bool removed;
 };
 
 #endif // CONFLICT_NODE_H
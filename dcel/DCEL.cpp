@@ -45,6 +45,14 @@ face DCEL::get_face( int i )	{
 	return F[i];
 };
 
+/** 
+  * \param i L'indice della faccia di interesse.
+  * \return il piano della faccia, valido finché la lista delle facce non viene modificata.
+  */
+const face_plane &DCEL::get_face_plane( int i ) const	{
+	return F.at(i).plane;
+};
+
 /**
  * \param v Il vertice da aggiungere alla DCEL.
  * \return l'indice del vertice aggiunto.
@@ -420,6 +428,101 @@ bool DCEL::delete_face( int f )
 	return true;
 }
 
+/**
+ * Rende il nuovo indice di un elemento dopo la compattazione,
+ * -1 se l'indice non è valido o l'elemento è stato rimosso.
+ */
+static int compacted_index( const QVector<int> &new_index, int i )	{
+	if ( i < 0 || i >= new_index.size() ) return -1;
+	return new_index[i];
+}
+
+/**
+ * Rimuove dalla DCEL tutti i vertici, gli half-edge e le facce che non si trovano
+ * sul convex hull, e rinumera quelli rimasti mantenendone l'ordine. A differenza di
+ * delete_vertex, delete_half_edge e delete_face, che scorrono l'intera DCEL a ogni
+ * rimozione, il costo è lineare nel numero totale di elementi: una passata calcola i
+ * nuovi indici e una seconda copia gli elementi rimasti aggiornandone i riferimenti.
+ * I riferimenti a elementi rimossi diventano -1; il prev di ogni half-edge e l'half-edge
+ * incidente di ogni vertice vengono ricalcolati dai next e dai from_vertex, in modo da
+ * indicare sempre elementi rimasti.
+ */
+void DCEL::compact( void )	{
+	QVector<int> new_vertex(V.size(), -1);
+	QVector<int> new_half_edge(HE.size(), -1);
+	QVector<int> new_face(F.size(), -1);
+	int nv = 0, nhe = 0, nf = 0;
+
+	for(int i=0; i<V.size(); i++)
+		if( V[i].is_in_convex_hull() ) new_vertex[i] = nv++;
+
+	for(int i=0; i<HE.size(); i++)
+		if( HE[i].is_in_convex_hull() ) new_half_edge[i] = nhe++;
+
+	for(int i=0; i<F.size(); i++)
+		if( F[i].is_in_convex_hull() ) new_face[i] = nf++;
+
+	QVector < vertex > compact_V(nv);
+	QVector < half_edge > compact_HE(nhe);
+	QVector < face > compact_F(nf);
+
+	for(int i=0; i<V.size(); i++)
+	{
+		if( new_vertex[i] == -1 ) continue;
+
+		vertex v = V[i];
+		v.set_incident_half_edge( -1 );
+		compact_V[new_vertex[i]] = v;
+	}
+
+	for(int i=0; i<HE.size(); i++)
+	{
+		if( new_half_edge[i] == -1 ) continue;
+
+		half_edge h = HE[i];
+		h.set_from_vertex( compacted_index(new_vertex, h.get_from_vertex()) );
+		h.set_to_vertex( compacted_index(new_vertex, h.get_to_vertex()) );
+		h.set_twin( compacted_index(new_half_edge, h.get_twin()) );
+		h.set_next( compacted_index(new_half_edge, h.get_next()) );
+		h.set_prev( -1 );
+		h.set_face( compacted_index(new_face, h.get_face()) );
+		compact_HE[new_half_edge[i]] = h;
+	}
+
+	for(int i=0; i<compact_HE.size(); i++)
+	{
+		int next = compact_HE[i].get_next();
+		int from = compact_HE[i].get_from_vertex();
+
+		if( next != -1 ) compact_HE[next].set_prev( i );
+		if( from != -1 ) compact_V[from].set_incident_half_edge( i );
+	}
+
+	for(int i=0; i<F.size(); i++)
+	{
+		if( new_face[i] == -1 ) continue;
+
+		face f = F[i];
+		f.set_inner_half_edge( compacted_index(new_half_edge, f.get_inner_half_edge()) );
+		f.set_outer_half_edge( compacted_index(new_half_edge, f.get_outer_half_edge()) );
+		compact_F[new_face[i]] = f;
+	}
+
+	V = compact_V;
+	HE = compact_HE;
+	F = compact_F;
+}
+
+/**
+ * Riserva lo spazio per \p nv vertici, \p nhe half-edge e \p nf facce, in modo che
+ * aggiungerli uno alla volta non richieda di riallocare le liste.
+ */
+void DCEL::reserve( int nv, int nhe, int nf )	{
+	V.reserve( nv );
+	HE.reserve( nhe );
+	F.reserve( nf );
+}
+
 /**
  * Per cancellazione si intende la rimozione di tutti i vertici,
  * gli half-edge e le facce precedentemente create, con relativa
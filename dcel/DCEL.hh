@@ -86,6 +86,9 @@ class DCEL	{
 	/** \brief Rende la faccia con indice i */
 	face get_face( int i );
 
+	/** \brief Rende il piano della faccia con indice i, senza copiare la faccia */
+	const face_plane &get_face_plane( int i ) const;
+
 	/** \brief Aggiunge un vertice e ne rende l'indice */
 	int add_vertex( vertex v );
 
@@ -170,6 +173,12 @@ class DCEL	{
 	/** \brief Rimuove la faccia specificata dalla lista */
 	bool delete_face ( int f );
 
+	/** \brief Rimuove tutti gli elementi che non si trovano sul convex hull, in un'unica passata */
+	void compact( void );
+
+	/** \brief Riserva lo spazio per il numero di elementi indicato */
+	void reserve( int nv, int nhe, int nf );
+
 	/** \brief Cancella la DCEL precedentemente creata */
 	void reset( void );
 
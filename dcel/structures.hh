@@ -300,6 +300,26 @@ struct half_edge	{
     };
 };
 
+/**
+ * \brief Struttura rappresentante il piano di una faccia.
+ *
+ * Un punto p vede la faccia se normal * (p - origin) > 0, dove normal è (c - a) x (b - a)
+ * per una faccia a, b, c in senso orario vista dall'esterno. Il vettore error contiene i coefficienti
+ * del limite dell'errore di arrotondamento del test, mentre i tre vertici servono per il test esatto
+ * quando il risultato è minore di tale limite.
+ */
+struct face_plane	{
+
+	///Vertici della faccia
+	CGPointf	vertexes[3];
+	///Punto del piano
+	double	origin[3];
+	///Normale al piano, non normalizzata
+	double	normal[3];
+	///Coefficienti del limite dell'errore
+	double	error[3];
+};
+
 /**
  * \brief Struttura rappresentante una faccia della DCEL.
  *
@@ -322,6 +342,9 @@ struct face	{
 	/// Normale alla faccia
 	CGPointf normal;
     
+    /// Piano della faccia, calcolato alla sua creazione
+    face_plane plane;
+    
     face(){
         in_convex_hull = true;
     };
@@ -340,6 +363,18 @@ struct face	{
 		normal = new_normal;
 	};
 
+	/** Rende il piano della faccia
+	 * \return Il piano della faccia */
+	virtual face_plane get_plane()		{
+		return plane;
+	};
+	
+	/** Imposta il piano della faccia
+	 * \param new_plane Il piano della faccia */
+	virtual void set_plane(face_plane new_plane)		{
+		plane = new_plane;
+	};
+
 	/** Rende l'indice dell'inner half-edge.
 	 * \return L'indice dell'inner half-edge */
 	virtual int get_inner_half_edge()	{
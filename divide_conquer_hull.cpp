@@ -0,0 +1,664 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "divide_conquer_hull.h"
+#include <algorithm>
+#include <QtConcurrentRun>
+#include "quickhull.h"
+#include "predicates.h"
+
+// Face of the band wrapped around two convex hulls: "a" is a vertex of the left one and "b" of the right one. The third
+// vertex "c" is a neighbour of "a" or "b" on the convex hull "side" (0 for the left one, 1 for the right one), and "edge" is
+// the half-edge of that convex hull between them, in the opposite sense of the one of the band face.
+struct band_face
+{
+    int a, b, c;
+    int side;
+    int edge;
+};
+
+// One of the two convex hulls being merged
+struct merge_side
+{
+    DCEL *convex_hull;
+    
+    // Band face with the twin of each half-edge, or -1
+    QVector<int> band;
+    
+    // Faces replaced by a band face, and the faces dropped with them
+    QVector<int> seeds;
+    QVector<char> hidden;
+    
+    // Positions of the vertexes, half-edges and faces in the merged convex hull, or -1 if they are dropped
+    QVector<int> vertexes;
+    QVector<int> half_edges;
+    QVector<int> faces;
+};
+
+// Point of an outline, with the index of its vertex
+struct outline_point
+{
+    CGPointf coord;
+    int index;
+};
+
+// Compare two points along x, then along y and z, so that the two halves of the sorted points can always be separated
+static bool less_xyz(const vertex &vertex1, const vertex &vertex2)
+{
+    const CGPointf &p1 = vertex1.coord, &p2 = vertex2.coord;
+    
+    if (p1.x != p2.x) return p1.x < p2.x;
+    if (p1.y != p2.y) return p1.y < p2.y;
+    
+    return p1.z < p2.z;
+}
+
+static bool less_xy(const CGPointf &p1, const CGPointf &p2)
+{
+    return p1.x < p2.x || (p1.x == p2.x && p1.y < p2.y);
+}
+
+static bool less_outline_point(const outline_point &point1, const outline_point &point2)
+{
+    return less_xy(point1.coord, point2.coord);
+}
+
+// Orientation of "c" with respect to the line from "a" to "b", projected on the xy plane: positive if "c" is on its left,
+// negative if it is on its right and zero if they are aligned. The projections on z = 0 are seen from (0, 0, 1), so the
+// exact sign is the opposite one of orient3d.
+static double orient2d(const CGPointf &a, const CGPointf &b, const CGPointf &c)
+{
+    return -orient3d(CGPointf(a.x, a.y, 0), CGPointf(b.x, b.y, 0), CGPointf(c.x, c.y, 0), CGPointf(0, 0, 1));
+}
+
+static CGPointf vertex_coord(DCEL &convex_hull, int v)
+{
+    return convex_hull.get_vertex(v).coord;
+}
+
+// Find the outline of a compacted convex hull with the monotone chain algorithm: the projections of the vertexes are sorted
+// along x, and the lower and upper chains leave out the ones which don't turn left.
+static void find_outline(DCEL &convex_hull, QVector<int> &outline)
+{
+    int points_n = convex_hull.get_vertex_n();
+    QVector<outline_point> points(points_n);
+    
+    for (int i = 0; i < points_n; i++) {
+        
+        points[i].coord = vertex_coord(convex_hull, i);
+        points[i].index = i;
+    }
+    
+    std::sort(points.begin(), points.end(), less_outline_point);
+    
+    QVector<outline_point> chain(2 * points_n);
+    int chain_n = 0;
+    
+    for (int i = 0; i < points_n; i++) {
+        
+        while (chain_n >= 2 && orient2d(chain[chain_n - 2].coord, chain[chain_n - 1].coord, points[i].coord) <= 0) {
+            
+            chain_n--;
+        }
+        
+        chain[chain_n++] = points[i];
+    }
+    
+    for (int i = points_n - 2, lower_n = chain_n + 1; i >= 0; i--) {
+        
+        while (chain_n >= lower_n && orient2d(chain[chain_n - 2].coord, chain[chain_n - 1].coord, points[i].coord) <= 0) {
+            
+            chain_n--;
+        }
+        
+        chain[chain_n++] = points[i];
+    }
+    
+    outline.clear();
+    
+    // The first point closes the upper chain
+    for (int i = 0; i < chain_n - 1; i++) {
+        
+        outline.append(chain[i].index);
+    }
+}
+
+// Find a bridge between the outlines of two convex hulls, the left one before the right one along x: the lower bridge leaves
+// all the projections on its left, the upper one on its right. "first" and "second" are the positions of its ends in the two
+// outlines. Return false if other projections are aligned with the bridge.
+static bool find_bridge(DCEL &left_hull, const QVector<int> &left_outline, DCEL &right_hull, const QVector<int> &right_outline,
+                        bool lower, int &first, int &second)
+{
+    int left_n = left_outline.size();
+    int right_n = right_outline.size();
+    
+    // Start from the last corner of the left outline along x and from the first one of the right outline
+    first = 0;
+    second = 0;
+    
+    for (int i = 1; i < left_n; i++) {
+        
+        if (less_xy(vertex_coord(left_hull, left_outline[first]), vertex_coord(left_hull, left_outline[i]))) {
+            
+            first = i;
+        }
+    }
+    
+    for (int i = 1; i < right_n; i++) {
+        
+        if (less_xy(vertex_coord(right_hull, right_outline[i]), vertex_coord(right_hull, right_outline[second]))) {
+            
+            second = i;
+        }
+    }
+    
+    // The lower bridge moves clockwise along the left outline and counterclockwise along the right one, the upper one the
+    // other way round
+    int side = lower ? 1 : -1;
+    int left_step = lower ? left_n - 1 : 1;
+    int right_step = lower ? 1 : right_n - 1;
+    bool moved = true;
+    
+    while (moved) {
+        
+        moved = false;
+        
+        for (;;) {
+            
+            int next = (first + left_step) % left_n;
+            double turn = side * orient2d(vertex_coord(left_hull, left_outline[first]), vertex_coord(right_hull, right_outline[second]),
+                                          vertex_coord(left_hull, left_outline[next]));
+            
+            if (turn > 0) break;
+            if (turn == 0) return false;
+            
+            first = next;
+            moved = true;
+        }
+        
+        for (;;) {
+            
+            int next = (second + right_step) % right_n;
+            double turn = side * orient2d(vertex_coord(left_hull, left_outline[first]), vertex_coord(right_hull, right_outline[second]),
+                                          vertex_coord(right_hull, right_outline[next]));
+            
+            if (turn > 0) break;
+            if (turn == 0) return false;
+            
+            second = next;
+            moved = true;
+        }
+    }
+    
+    // The other neighbours of the ends have to be strictly on the same side too
+    CGPointf coord_a = vertex_coord(left_hull, left_outline[first]);
+    CGPointf coord_b = vertex_coord(right_hull, right_outline[second]);
+    
+    return side * orient2d(coord_a, coord_b, vertex_coord(left_hull, left_outline[(first + left_n - left_step) % left_n])) > 0 &&
+           side * orient2d(coord_a, coord_b, vertex_coord(right_hull, right_outline[(second + right_n - right_step) % right_n])) > 0;
+}
+
+// Look for the third vertex of the band face on the edge from "coord_a" to "coord_b" among the neighbours of "center" on the
+// convex hull "side": a neighbour replaces the current third vertex if it is above the face. Return false if a neighbour is
+// on the plane of the face.
+static bool find_third_vertex(merge_side &side, int side_id, int center, const CGPointf &coord_a, const CGPointf &coord_b,
+                              band_face &face, CGPointf &coord_c)
+{
+    DCEL &convex_hull = *side.convex_hull;
+    int first = convex_hull.get_vertex(center).get_incident_half_edge();
+    int h = first;
+    
+    do {
+        
+        half_edge real_h = convex_hull.get_half_edge(h);
+        CGPointf coord = vertex_coord(convex_hull, real_h.get_to_vertex());
+        double orientation = face.c == -1 ? 1 : orient3d(coord_a, coord_b, coord_c, coord);
+        
+        if (orientation == 0) {
+            
+            return false;
+        }
+        
+        if (orientation > 0) {
+            
+            face.c = real_h.get_to_vertex();
+            face.side = side_id;
+            face.edge = side_id == 0 ? h : real_h.get_twin();
+            coord_c = coord;
+        }
+        
+        // The next half-edge leaving the center
+        h = convex_hull.get_half_edge(real_h.get_twin()).get_next();
+    } while (h != first);
+    
+    return true;
+}
+
+// Hide the faces of a convex hull reached from its seeds without crossing the band. If no face was replaced, the convex hull
+// touches the band only in a vertex and all its faces are hidden. Return false if the band doesn't separate the faces: a
+// face is kept if its half-edge has a twin in the band, unless the band is on both sides of the edge.
+static bool hide_inner_faces(merge_side &side)
+{
+    DCEL &convex_hull = *side.convex_hull;
+    QVector<int> stack = side.seeds;
+    
+    side.hidden.fill(side.seeds.isEmpty(), convex_hull.get_faces_n());
+    
+    for (int i = 0; i < side.seeds.size(); i++) {
+        
+        side.hidden[side.seeds[i]] = true;
+    }
+    
+    while (!stack.isEmpty()) {
+        
+        int h = convex_hull.get_face(stack.takeLast()).get_inner_half_edge();
+        
+        for (int i = 0; i < 3; i++) {
+            
+            half_edge real_h = convex_hull.get_half_edge(h);
+            
+            if (side.band[h] == -1 && side.band[real_h.get_twin()] == -1) {
+                
+                int neighbour = convex_hull.get_half_edge(real_h.get_twin()).get_face();
+                
+                if (!side.hidden[neighbour]) {
+                    
+                    side.hidden[neighbour] = true;
+                    stack.append(neighbour);
+                }
+            }
+            
+            h = real_h.get_next();
+        }
+    }
+    
+    for (int i = 0; i < convex_hull.get_half_edge_n(); i++) {
+        
+        if (side.band[i] != -1) {
+            
+            half_edge real_h = convex_hull.get_half_edge(i);
+            
+            if (side.hidden[real_h.get_face()] != (side.band[real_h.get_twin()] != -1)) {
+                
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
+
+bool divide_conquer_hull::calculate(QVector<vertex> &vertex_list, DCEL &convex_hull)
+{
+    std::sort(vertex_list.begin(), vertex_list.end(), less_xyz);
+    
+    divide_conquer_part part = hull_part(vertex_list.constData(), vertex_list.size());
+    
+    if (!part.volume) {
+        
+        return false;
+    }
+    
+    convex_hull = part.convex_hull;
+    
+    return true;
+}
+
+// Compute the convex hull of the "points_n" sorted points from "points". The two halves are computed in parallel: one is
+// queued on the global thread pool and the other runs in the current thread. While waiting, QFuture::waitForFinished() runs
+// the queued half itself if no thread of the pool has taken it yet, so uneven splits don't leave the waiting thread idle.
+divide_conquer_part divide_conquer_hull::hull_part(const vertex *points, int points_n)
+{
+    int half = points_n / 2;
+    
+    // Equal points stay in the same half, so the halves are separated along the sorting order
+    while (half > 0 && half < points_n && !less_xyz(points[half - 1], points[half])) {
+        
+        half++;
+    }
+    
+    if (points_n <= DIVIDE_CONQUER_LEAF || half == points_n) {
+        
+        QVector<vertex> subset(points_n);
+        std::copy(points, points + points_n, subset.begin());
+        
+        return direct_part(subset);
+    }
+    
+    QFuture<divide_conquer_part> left = QtConcurrent::run(this, &divide_conquer_hull::hull_part, points, half);
+    divide_conquer_part right = hull_part(points + half, points_n - half);
+    
+    left.waitForFinished();
+    
+    divide_conquer_part left_part = left.result();
+    
+    return merge(left_part, right);
+}
+
+// Compute the convex hull of a subset directly with quickhull
+divide_conquer_part divide_conquer_hull::direct_part(const QVector<vertex> &points)
+{
+    divide_conquer_part part;
+    quickhull hull;
+    
+    part.volume = hull.calculate(points, part.convex_hull);
+    
+    if (!part.volume) {
+        
+        part.convex_hull.reset();
+        part.flat_points = points;
+        
+        return part;
+    }
+    
+    part.convex_hull.compact();
+    find_outline(part.convex_hull, part.outline);
+    
+    return part;
+}
+
+// Merge the convex hulls of two halves. If a half doesn't span a volume, or the points are not in general position and the
+// band can't be wrapped, the convex hull is computed directly from the vertexes of the two convex hulls.
+divide_conquer_part divide_conquer_hull::merge(divide_conquer_part &left, divide_conquer_part &right)
+{
+    divide_conquer_part merged;
+    
+    if (left.volume && right.volume && wrap(left, right, merged)) {
+        
+        return merged;
+    }
+    
+    QVector<vertex> points = left.volume ? left.convex_hull.get_all_vertexes() : left.flat_points;
+    points += right.volume ? right.convex_hull.get_all_vertexes() : right.flat_points;
+    
+    return direct_part(points);
+}
+
+// Wrap a band of new faces around two convex hulls, separated along x, and merge them into "merged". The lower bridge between
+// the outlines is an edge of the merged convex hull, and each band face is built on the last edge between the two convex
+// hulls: its third vertex is the neighbour of the ends of the edge which leaves all the other ones below the face. The band
+// is closed when the wrap comes back to the lower bridge. A band face with two vertexes on a convex hull replaces the face of
+// that convex hull on the same edge, and the faces reached from the replaced ones without crossing the band are dropped.
+// Return false if some points are not in general position, so the band can't be wrapped.
+bool divide_conquer_hull::wrap(divide_conquer_part &left, divide_conquer_part &right, divide_conquer_part &merged)
+{
+    merge_side sides[2];
+    sides[0].convex_hull = &left.convex_hull;
+    sides[1].convex_hull = &right.convex_hull;
+    
+    int lower_left, lower_right, upper_left, upper_right;
+    
+    if (!find_bridge(left.convex_hull, left.outline, right.convex_hull, right.outline, true, lower_left, lower_right) ||
+        !find_bridge(left.convex_hull, left.outline, right.convex_hull, right.outline, false, upper_left, upper_right)) {
+        
+        return false;
+    }
+    
+    QVector<band_face> band;
+    int start_a = left.outline[lower_left];
+    int start_b = right.outline[lower_right];
+    int a = start_a, b = start_b;
+    int max_faces = left.convex_hull.get_half_edge_n() + right.convex_hull.get_half_edge_n();
+    
+    do {
+        
+        if (band.size() == max_faces) {
+            
+            return false;
+        }
+        
+        band_face face;
+        face.a = a;
+        face.b = b;
+        face.c = -1;
+        
+        CGPointf coord_a = vertex_coord(left.convex_hull, a);
+        CGPointf coord_b = vertex_coord(right.convex_hull, b);
+        CGPointf coord_c;
+        
+        if (!find_third_vertex(sides[0], 0, a, coord_a, coord_b, face, coord_c) ||
+            !find_third_vertex(sides[1], 1, b, coord_a, coord_b, face, coord_c)) {
+            
+            return false;
+        }
+        
+        band.append(face);
+        
+        // The next face is built on the new edge between the two convex hulls
+        if (face.side == 0) {
+            
+            a = face.c;
+        } else {
+            
+            b = face.c;
+        }
+    } while (a != start_a || b != start_b);
+    
+    // The band face (a, b, c) replaces the face with the half-edge from c to a, or from b to c. The band can touch an edge
+    // on both sides, and then the faces on both sides are replaced.
+    for (int i = 0; i < 2; i++) {
+        
+        sides[i].band.fill(-1, sides[i].convex_hull->get_half_edge_n());
+    }
+    
+    for (int i = 0; i < band.size(); i++) {
+        
+        merge_side &side = sides[band[i].side];
+        int replaced = side.convex_hull->get_half_edge(band[i].edge).get_twin();
+        
+        side.band[band[i].edge] = i;
+        side.seeds.append(side.convex_hull->get_half_edge(replaced).get_face());
+    }
+    
+    if (!hide_inner_faces(sides[0]) || !hide_inner_faces(sides[1])) {
+        
+        return false;
+    }
+    
+    // Number the elements left on the merged convex hull: first the ones of the left convex hull, then the ones of the right
+    // convex hull and finally the band faces with their half-edges
+    DCEL &convex_hull = merged.convex_hull;
+    int vertex_n = 0;
+    int half_edge_n = 0;
+    int face_n = 0;
+    
+    for (int i = 0; i < 2; i++) {
+        
+        merge_side &side = sides[i];
+        DCEL &side_hull = *side.convex_hull;
+        
+        side.vertexes.fill(-1, side_hull.get_vertex_n());
+        side.half_edges.fill(-1, side_hull.get_half_edge_n());
+        side.faces.fill(-1, side_hull.get_faces_n());
+        
+        for (int j = 0; j < side_hull.get_half_edge_n(); j++) {
+            
+            half_edge real_h = side_hull.get_half_edge(j);
+            
+            // The vertexes left are marked with 0, and numbered when they are added
+            if (!side.hidden[real_h.get_face()]) {
+                
+                side.half_edges[j] = half_edge_n++;
+                side.vertexes[real_h.get_from_vertex()] = 0;
+            }
+        }
+        
+        for (int j = 0; j < side_hull.get_faces_n(); j++) {
+            
+            if (!side.hidden[j]) {
+                
+                side.faces[j] = face_n++;
+            }
+        }
+    }
+    
+    // A convex hull touching the band only in a vertex keeps just that vertex
+    for (int i = 0; i < band.size(); i++) {
+        
+        sides[0].vertexes[band[i].a] = 0;
+        sides[1].vertexes[band[i].b] = 0;
+        sides[band[i].side].vertexes[band[i].c] = 0;
+    }
+    
+    for (int i = 0; i < 2; i++) {
+        
+        for (int j = 0; j < sides[i].vertexes.size(); j++) {
+            
+            if (sides[i].vertexes[j] == 0) {
+                
+                sides[i].vertexes[j] = vertex_n++;
+            }
+        }
+    }
+    
+    int band_half_edges = half_edge_n;
+    int band_faces = face_n;
+    
+    convex_hull.reserve(vertex_n, half_edge_n + 3 * band.size(), face_n + band.size());
+    
+    for (int i = 0; i < 2; i++) {
+        
+        for (int j = 0; j < sides[i].vertexes.size(); j++) {
+            
+            if (sides[i].vertexes[j] != -1) {
+                
+                convex_hull.add_vertex(sides[i].convex_hull->get_vertex(j));
+            }
+        }
+    }
+    
+    // The half-edges left on the convex hulls keep their twins, except the ones on the band. Each vertex takes the last
+    // half-edge added from it as incident half-edge.
+    for (int i = 0; i < 2; i++) {
+        
+        merge_side &side = sides[i];
+        DCEL &side_hull = *side.convex_hull;
+        
+        for (int j = 0; j < side_hull.get_half_edge_n(); j++) {
+            
+            if (side.half_edges[j] == -1) {
+                
+                continue;
+            }
+            
+            half_edge real_h = side_hull.get_half_edge(j);
+            
+            real_h.set_from_vertex(side.vertexes[real_h.get_from_vertex()]);
+            real_h.set_to_vertex(side.vertexes[real_h.get_to_vertex()]);
+            real_h.set_next(side.half_edges[real_h.get_next()]);
+            real_h.set_prev(side.half_edges[real_h.get_prev()]);
+            real_h.set_face(side.faces[real_h.get_face()]);
+            
+            if (side.band[j] == -1) {
+                
+                real_h.set_twin(side.half_edges[real_h.get_twin()]);
+            } else {
+                
+                real_h.set_twin(band_half_edges + 3 * side.band[j] + (i == 0 ? 2 : 1));
+            }
+            
+            convex_hull.set_vertex_incident(real_h.get_from_vertex(), convex_hull.add_half_edge(real_h));
+        }
+    }
+    
+    // The band face (a, b, c) has the half-edges from a to b, from b to c and from c to a. The one from a to b is shared with
+    // the previous band face, and the other one between the two convex hulls with the next band face. The half-edges and
+    // faces they refer to are added later, so their fields are set before adding them.
+    for (int i = 0; i < band.size(); i++) {
+        
+        const band_face &face = band[i];
+        merge_side &side = sides[face.side];
+        
+        int previous = (i + band.size() - 1) % band.size();
+        int next = (i + 1) % band.size();
+        
+        int first = band_half_edges + 3 * i;
+        int previous_bridge = band_half_edges + 3 * previous + (band[previous].side == 0 ? 1 : 2);
+        int next_bridge = band_half_edges + 3 * next;
+        int hull_edge = side.half_edges[face.edge];
+        
+        // The band can be on both sides of an edge of a convex hull
+        if (hull_edge == -1) {
+            
+            int other = side.band[side.convex_hull->get_half_edge(face.edge).get_twin()];
+            
+            hull_edge = band_half_edges + 3 * other + (face.side == 0 ? 2 : 1);
+        }
+        
+        int corners[3] = {sides[0].vertexes[face.a], sides[1].vertexes[face.b], side.vertexes[face.c]};
+        int twins[3] = {previous_bridge, face.side == 0 ? next_bridge : hull_edge, face.side == 0 ? hull_edge : next_bridge};
+        
+        for (int j = 0; j < 3; j++) {
+            
+            half_edge new_half_edge;
+            
+            new_half_edge.set_from_vertex(corners[j]);
+            new_half_edge.set_to_vertex(corners[(j + 1) % 3]);
+            new_half_edge.set_twin(twins[j]);
+            new_half_edge.set_next(first + (j + 1) % 3);
+            new_half_edge.set_prev(first + (j + 2) % 3);
+            new_half_edge.set_face(band_faces + i);
+            
+            convex_hull.set_vertex_incident(corners[j], convex_hull.add_half_edge(new_half_edge));
+        }
+    }
+    
+    for (int i = 0; i < 2; i++) {
+        
+        merge_side &side = sides[i];
+        
+        for (int j = 0; j < side.convex_hull->get_faces_n(); j++) {
+            
+            if (side.faces[j] != -1) {
+                
+                face real_f = side.convex_hull->get_face(j);
+                
+                real_f.set_inner_half_edge(side.half_edges[real_f.get_inner_half_edge()]);
+                convex_hull.add_face(real_f);
+            }
+        }
+    }
+    
+    for (int i = 0; i < band.size(); i++) {
+        
+        create_face(convex_hull, band_half_edges + 3 * i);
+    }
+    
+    // The outline goes from the lower bridge along the right outline up to the upper bridge, and back along the left outline
+    merged.outline.clear();
+    
+    for (int i = lower_right; ; i = (i + 1) % right.outline.size()) {
+        
+        merged.outline.append(sides[1].vertexes[right.outline[i]]);
+        
+        if (i == upper_right) break;
+    }
+    
+    for (int i = upper_left; ; i = (i + 1) % left.outline.size()) {
+        
+        merged.outline.append(sides[0].vertexes[left.outline[i]]);
+        
+        if (i == lower_left) break;
+    }
+    
+    merged.volume = true;
+    
+    return !merged.outline.contains(-1);
+}
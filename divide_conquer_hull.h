@@ -0,0 +1,62 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DIVIDE_CONQUER_HULL_H
+#define DIVIDE_CONQUER_HULL_H
+
+#include "hull_algorithm.h"
+
+// Under this number of points, a subset is computed directly instead of being split again
+#define DIVIDE_CONQUER_LEAF 4096
+
+// Convex hull of a subset of the points, with the outline of its projection on the xy plane
+struct divide_conquer_part
+{
+    // Compacted convex hull, empty if the points don't span a volume
+    DCEL convex_hull;
+    bool volume;
+    
+    // Vertexes of the convex hull whose projections are the corners of its projection, in counterclockwise sense
+    QVector<int> outline;
+    
+    // All the points of the subset, kept only if they don't span a volume
+    QVector<vertex> flat_points;
+};
+
+// Divide and conquer algorithm: the points are sorted along x and split in halves, whose convex hulls are
+// computed in parallel on the global thread pool. The convex hulls of two halves are merged wrapping a band
+// of new faces around them, from the lower bridge between the outlines of their projections, and dropping
+// the faces of each half left inside the band.
+class divide_conquer_hull : public hull_algorithm
+{
+    public:
+        
+        bool calculate(QVector<vertex> &vertex_list, DCEL &convex_hull);
+        
+    private:
+        
+        divide_conquer_part hull_part(const vertex *points, int points_n);
+        divide_conquer_part direct_part(const QVector<vertex> &points);
+        divide_conquer_part merge(divide_conquer_part &left, divide_conquer_part &right);
+        
+        bool wrap(divide_conquer_part &left, divide_conquer_part &right, divide_conquer_part &merged);
+};
+
+#endif // DIVIDE_CONQUER_HULL_H
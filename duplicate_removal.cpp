@@ -0,0 +1,220 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "duplicate_removal.h"
+#include <cmath>
+#include <cstring>
+#include <QHash>
+#include <QThread>
+#include <QtConcurrentMap>
+
+uint qHash(const point_key &key, uint seed)
+{
+    quint64 h = (quint64)key.x * 0x9E3779B97F4A7C15ULL;
+    
+    h = (h ^ (quint64)key.y) * 0x9E3779B97F4A7C15ULL;
+    h = (h ^ (quint64)key.z) * 0x9E3779B97F4A7C15ULL;
+    
+    return (uint)(h >> 32) ^ seed;
+}
+
+int duplicate_removal::remove(QVector<vertex> &vertex_list, double tolerance)
+{
+    int points_n = vertex_list.size();
+    int chunks_n = QThread::idealThreadCount();
+    
+    QVector<point_key> keys(points_n);
+    QVector<int> representative(points_n);
+    
+    // Compute the keys in parallel, one range of points per thread
+    QVector<duplicate_chunk> chunks(chunks_n);
+    
+    for (int i = 0; i < chunks_n; i++) {
+        
+        chunks[i].vertex_list = &vertex_list;
+        chunks[i].tolerance = tolerance;
+        chunks[i].begin = (qint64)points_n * i / chunks_n;
+        chunks[i].end = (qint64)points_n * (i + 1) / chunks_n;
+        chunks[i].keys = keys.data();
+        chunks[i].representative = representative.data();
+    }
+    
+    QtConcurrent::blockingMap(chunks, compute_keys);
+    
+    // The points with the same key get the same hash, so they fall in the same bucket. The bucket is chosen with the
+    // high bits of the hash, as the hash tables of the buckets use the low ones.
+    for (int i = 0; i < points_n; i++) {
+        
+        chunks[(qHash(keys.at(i)) >> 16) % chunks_n].points.append(i);
+    }
+    
+    QtConcurrent::blockingMap(chunks, find_duplicates);
+    
+    // Keep the first point of each key, in the order of the list: each range is copied in parallel after the points kept
+    // in the earlier ranges, then the duplicates are mapped to the position of their representative
+    QtConcurrent::blockingMap(chunks, count_kept);
+    
+    int kept_n = 0;
+    
+    for (int i = 0; i < chunks_n; i++) {
+        
+        chunks[i].first_kept = kept_n;
+        kept_n += chunks[i].kept_n;
+    }
+    
+    QVector<vertex> kept_points(kept_n);
+    original_indexes.resize(kept_n);
+    kept_indexes.resize(points_n);
+    
+    for (int i = 0; i < chunks_n; i++) {
+        
+        chunks[i].kept_points = kept_points.data();
+        chunks[i].original_indexes = original_indexes.data();
+        chunks[i].kept_indexes = kept_indexes.data();
+    }
+    
+    QtConcurrent::blockingMap(chunks, copy_kept);
+    QtConcurrent::blockingMap(chunks, map_duplicates);
+    
+    vertex_list = kept_points;
+    
+    return points_n - kept_n;
+}
+
+const QVector<int> &duplicate_removal::get_original_indexes(void) const
+{
+    return original_indexes;
+}
+
+const QVector<int> &duplicate_removal::get_kept_indexes(void) const
+{
+    return kept_indexes;
+}
+
+// Bits of a coordinate, the same for -0 and 0
+static qint64 coordinate_bits(float coordinate)
+{
+    float x = coordinate + 0.0f;
+    quint32 bits;
+    
+    memcpy(&bits, &x, sizeof(bits));
+    
+    return bits;
+}
+
+// Cell of a coordinate in the grid of side "tolerance". Casting a quotient out of the range of qint64 is undefined, so beyond
+// DUPLICATE_CELL_LIMIT cells, or for NaN, the key is the bits of the coordinate past the limit. There two different coordinates are
+// farther than the tolerance, as the quotient is larger than 2^53, so no point within the tolerance is missed.
+static qint64 grid_cell(float coordinate, double tolerance)
+{
+    double cell = std::floor(coordinate / tolerance);
+    
+    if (cell > -DUPLICATE_CELL_LIMIT && cell < DUPLICATE_CELL_LIMIT) {
+        
+        return (qint64)cell;
+    }
+    
+    return (qint64)DUPLICATE_CELL_LIMIT + coordinate_bits(coordinate);
+}
+
+// Compute the key of the points of a chunk.
+void duplicate_removal::compute_keys(duplicate_chunk &chunk)
+{
+    for (int i = chunk.begin; i < chunk.end; i++) {
+        
+        const CGPointf &p = chunk.vertex_list->at(i).coord;
+        point_key &key = chunk.keys[i];
+        
+        if (chunk.tolerance > 0) {
+            
+            key.x = grid_cell(p.x, chunk.tolerance);
+            key.y = grid_cell(p.y, chunk.tolerance);
+            key.z = grid_cell(p.z, chunk.tolerance);
+        } else {
+            
+            key.x = coordinate_bits(p.x);
+            key.y = coordinate_bits(p.y);
+            key.z = coordinate_bits(p.z);
+        }
+    }
+}
+
+// Map each point of a bucket to the first point of the bucket with its key. The buckets have disjoint points, so they can run in parallel.
+void duplicate_removal::find_duplicates(duplicate_chunk &chunk)
+{
+    QHash<point_key, int> first;
+    
+    for (int i = 0; i < chunk.points.size(); i++) {
+        
+        int point = chunk.points.at(i);
+        QHash<point_key, int>::iterator found = first.find(chunk.keys[point]);
+        
+        if (found == first.end()) {
+            
+            first.insert(chunk.keys[point], point);
+            chunk.representative[point] = point;
+        } else {
+            
+            chunk.representative[point] = found.value();
+        }
+    }
+}
+
+void duplicate_removal::count_kept(duplicate_chunk &chunk)
+{
+    chunk.kept_n = 0;
+    
+    for (int i = chunk.begin; i < chunk.end; i++) {
+        
+        if (chunk.representative[i] == i) {
+            
+            chunk.kept_n++;
+        }
+    }
+}
+
+// Copy the points kept in the range of the chunk, recording where each of them comes from and where it goes
+void duplicate_removal::copy_kept(duplicate_chunk &chunk)
+{
+    int kept = chunk.first_kept;
+    
+    for (int i = chunk.begin; i < chunk.end; i++) {
+        
+        if (chunk.representative[i] == i) {
+            
+            chunk.kept_points[kept] = chunk.vertex_list->at(i);
+            chunk.original_indexes[kept] = i;
+            chunk.kept_indexes[i] = kept;
+            kept++;
+        }
+    }
+}
+
+// Map each duplicate of the range to the position of its representative, which may be in another range, so it runs after copy_kept()
+void duplicate_removal::map_duplicates(duplicate_chunk &chunk)
+{
+    for (int i = chunk.begin; i < chunk.end; i++) {
+        
+        if (chunk.representative[i] != i) {
+            
+            chunk.kept_indexes[i] = chunk.kept_indexes[chunk.representative[i]];
+        }
+    }
+}
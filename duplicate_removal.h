@@ -0,0 +1,99 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DUPLICATE_REMOVAL_H
+#define DUPLICATE_REMOVAL_H
+
+#include <QVector>
+#include <QtGlobal>
+#include "dcel/DCEL.hh"
+
+// Largest cell of the grid kept as it is: beyond it a coordinate is keyed by its bits, offset by this value
+#define DUPLICATE_CELL_LIMIT 4611686018427387904.0
+
+// Cell of a point in the grid of the tolerance, or the bits of its coordinates when the duplicates must be exact
+struct point_key
+{
+    qint64 x;
+    qint64 y;
+    qint64 z;
+    
+    bool operator==(const point_key &other) const { return x == other.x && y == other.y && z == other.z; }
+};
+
+uint qHash(const point_key &key, uint seed = 0);
+
+// Range of points whose keys are computed by one thread, then bucket of points with the same hash searched for duplicates by one thread.
+// At last, the points kept in the range are copied by one thread, from the position after the ones kept in the earlier ranges.
+struct duplicate_chunk
+{
+    const QVector<vertex> *vertex_list;
+    double tolerance;
+    
+    int begin;
+    int end;
+    
+    // Keys of all the points, and the first point found with the same key of each point
+    point_key *keys;
+    int *representative;
+    
+    // Points of the bucket, in the order of the list
+    QVector<int> points;
+    
+    // Points kept in the range, and the position of the first one in the reduced list
+    int kept_n;
+    int first_kept;
+    
+    // Reduced list, with the mappings between its positions and the ones in the original list
+    vertex *kept_points;
+    int *original_indexes;
+    int *kept_indexes;
+};
+
+// Removal of the duplicate points before computing the convex hull: each duplicate would get its own node in the conflict graph
+// and its own visibility tests. The points are hashed into one bucket per thread, and each bucket is searched in parallel.
+class duplicate_removal
+{
+    public:
+        
+        // Remove from "vertex_list" the points with the same coordinates of an earlier point or, if "tolerance" is positive, in the
+        // same cell of a grid of side "tolerance", so the points removed are within tolerance * sqrt(3) of the one kept.
+        // Return the number of points removed.
+        int remove(QVector<vertex> &vertex_list, double tolerance);
+        
+        // Position in the original list of each point kept
+        const QVector<int> &get_original_indexes(void) const;
+        
+        // Position in the reduced list of the point kept for each point of the original list
+        const QVector<int> &get_kept_indexes(void) const;
+        
+    private:
+        
+        static void compute_keys(duplicate_chunk &chunk);
+        static void find_duplicates(duplicate_chunk &chunk);
+        static void count_kept(duplicate_chunk &chunk);
+        static void copy_kept(duplicate_chunk &chunk);
+        static void map_duplicates(duplicate_chunk &chunk);
+        
+        QVector<int> original_indexes;
+        QVector<int> kept_indexes;
+};
+
+#endif // DUPLICATE_REMOVAL_H
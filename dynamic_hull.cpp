@@ -0,0 +1,318 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dynamic_hull.h"
+#include "quickhull.h"
+#include "point_block.h"
+
+dynamic_bucket::dynamic_bucket()
+{
+    removed_n = 0;
+    stale = false;
+    
+    hull.flat = true;
+    hull.start = 0;
+}
+
+dynamic_hull::dynamic_hull()
+{
+    next_id = 0;
+    hull_changed = true;
+    hull_built = false;
+}
+
+// Merge the full buckets with the new point into the first empty bucket.
+int dynamic_hull::insert(const vertex &point)
+{
+    int point_id = next_id++;
+    
+    vertex new_point = point;
+    new_point.set_card(point_id);
+    
+    QVector<int> ids(1, point_id);
+    QVector<vertex> points(1, new_point);
+    
+    int level = 0;
+    
+    while (level < buckets.size() && !buckets[level].ids.isEmpty()) {
+        
+        take_points(level, ids, points);
+        level++;
+    }
+    
+    if (level == buckets.size()) {
+        
+        buckets.resize(level + 1);
+    }
+    
+    fill_bucket(level, ids, points);
+    
+    // The convex hull of all the points only grows, so the point is merged with its vertexes at the next query
+    if (hull_built && !hull_changed) {
+        
+        inserted.insert(point_id, new_point);
+    }
+    else {
+        
+        hull_changed = true;
+    }
+    
+    return point_id;
+}
+
+// Mark the point as removed. Its bucket is rebuilt when more than half of its points are removed.
+bool dynamic_hull::remove(int point_id)
+{
+    if (!point_level.contains(point_id)) {
+        
+        return false;
+    }
+    
+    int level = point_level.take(point_id);
+    dynamic_bucket &bucket = buckets[level];
+    int position = bucket.positions.take(point_id);
+    
+    bucket.ids[position] = -1;
+    bucket.removed_n++;
+    
+    // The convex hull of the bucket changes only if the point is one of its vertexes
+    if (bucket.hull_ids.remove(point_id)) {
+        
+        bucket.stale = true;
+    }
+    
+    if (bucket.removed_n * 2 > bucket.ids.size()) {
+        
+        QVector<int> ids;
+        QVector<vertex> points;
+        
+        take_points(level, ids, points);
+        fill_bucket(level, ids, points);
+    }
+    
+    // The same holds for the convex hull of all the points, unless the point hasn't been merged with it yet
+    if (hull_ids.contains(point_id)) {
+        
+        hull_changed = true;
+    }
+    
+    inserted.remove(point_id);
+    
+    return true;
+}
+
+int dynamic_hull::size() const
+{
+    return point_level.size();
+}
+
+// The farthest point is the farthest of the extreme points of the buckets.
+bool dynamic_hull::extreme_point(const double direction[3], vertex &extreme)
+{
+    const double origin[3] = {0, 0, 0};
+    
+    bool found = false;
+    double extreme_distance = 0;
+    
+    for (int i = 0; i < buckets.size(); i++) {
+        
+        if (buckets[i].ids.size() == buckets[i].removed_n) {
+            
+            continue;
+        }
+        
+        update_bucket_hull(i);
+        
+        group_hull &bucket_hull = buckets[i].hull;
+        double distance;
+        int vertex_id = extreme_vertex(bucket_hull, direction, origin, distance);
+        
+        if (!found || distance > extreme_distance) {
+            
+            found = true;
+            extreme = bucket_hull.vertexes[vertex_id];
+            extreme_distance = distance;
+        }
+    }
+    
+    return found;
+}
+
+// The convex hull only grows with the points inserted since the last update, so a point inside it is contained without merging them.
+bool dynamic_hull::contains(const vertex &point)
+{
+    if (hull_built && !hull_changed && hull_contains(point)) {
+        
+        return true;
+    }
+    
+    if (!hull_changed && inserted.isEmpty()) {
+        
+        return false;
+    }
+    
+    return update_convex_hull() && hull_contains(point);
+}
+
+bool dynamic_hull::get_convex_hull(DCEL &convex_hull)
+{
+    if (!update_convex_hull()) {
+        
+        return false;
+    }
+    
+    convex_hull = hull;
+    
+    return true;
+}
+
+// Put the points in the bucket, which has to be empty, and build their convex hull.
+void dynamic_hull::fill_bucket(int level, QVector<int> &ids, QVector<vertex> &points)
+{
+    dynamic_bucket &bucket = buckets[level];
+    
+    bucket.ids = ids;
+    bucket.points = points;
+    bucket.removed_n = 0;
+    
+    for (int i = 0; i < ids.size(); i++) {
+        
+        bucket.positions.insert(ids[i], i);
+        point_level.insert(ids[i], level);
+    }
+    
+    bucket.stale = true;
+    update_bucket_hull(level);
+}
+
+// Append the points of the bucket not removed to "ids" and "points", and empty the bucket.
+void dynamic_hull::take_points(int level, QVector<int> &ids, QVector<vertex> &points)
+{
+    dynamic_bucket &bucket = buckets[level];
+    
+    for (int i = 0; i < bucket.ids.size(); i++) {
+        
+        if (bucket.ids[i] != -1) {
+            
+            ids.append(bucket.ids[i]);
+            points.append(bucket.points[i]);
+        }
+    }
+    
+    bucket = dynamic_bucket();
+}
+
+// Build again the convex hull of the bucket from the points not removed, if one of its vertexes has been removed.
+void dynamic_hull::update_bucket_hull(int level)
+{
+    dynamic_bucket &bucket = buckets[level];
+    
+    if (!bucket.stale) {
+        
+        return;
+    }
+    
+    bucket.hull.vertexes.clear();
+    
+    for (int i = 0; i < bucket.points.size(); i++) {
+        
+        if (bucket.ids[i] != -1) {
+            
+            bucket.hull.vertexes.append(bucket.points[i]);
+        }
+    }
+    
+    if (!bucket.hull.vertexes.isEmpty()) {
+        
+        build_group_hull(bucket.hull);
+    }
+    
+    bucket.hull_ids.clear();
+    
+    for (int i = 0; i < bucket.hull.vertexes.size(); i++) {
+        
+        bucket.hull_ids.insert(bucket.hull.vertexes[i].get_card());
+    }
+    
+    bucket.stale = false;
+}
+
+// Update the convex hull of all the points: merge the points inserted since the last update with its vertexes or, if one of them
+// has been removed, compute it again from the vertexes of the convex hulls of the buckets.
+bool dynamic_hull::update_convex_hull(void)
+{
+    QVector<vertex> candidates;
+    
+    if (hull_changed) {
+        
+        for (int i = 0; i < buckets.size(); i++) {
+            
+            update_bucket_hull(i);
+            candidates += buckets[i].hull.vertexes;
+        }
+    }
+    else if (!inserted.isEmpty()) {
+        
+        candidates = hull.get_all_vertexes();
+        
+        for (QHash<int, vertex>::const_iterator i = inserted.constBegin(); i != inserted.constEnd(); ++i) {
+            
+            candidates.append(i.value());
+        }
+    }
+    else {
+        
+        return hull_built;
+    }
+    
+    quickhull convex_hull;
+    
+    hull.reset();
+    hull_ids.clear();
+    inserted.clear();
+    
+    hull_built = convex_hull.calculate(candidates, hull);
+    hull_changed = false;
+    
+    if (hull_built) {
+        
+        hull.compact();
+        
+        for (int i = 0; i < hull.get_vertex_n(); i++) {
+            
+            hull_ids.insert(hull.get_vertex_card(i));
+        }
+    }
+    
+    return hull_built;
+}
+
+bool dynamic_hull::hull_contains(const vertex &point)
+{
+    for (int i = 0; i < hull.get_faces_n(); i++) {
+        
+        if (plane_distance(hull.get_face_plane(i), point.coord) > 0) {
+            
+            return false;
+        }
+    }
+    
+    return true;
+}
@@ -0,0 +1,102 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DYNAMIC_HULL_H
+#define DYNAMIC_HULL_H
+
+#include <QHash>
+#include <QSet>
+#include "group_hull.h"
+
+// Points of a bucket of the dynamic hull, with the convex hull of the ones not removed. The id of a removed point is set to -1,
+// and the card of each point is its id, so that the vertexes of the convex hulls carry it.
+struct dynamic_bucket
+{
+    dynamic_bucket();
+    
+    QVector<int> ids;
+    QVector<vertex> points;
+    int removed_n;
+    
+    // Position of each point in the bucket, from its id
+    QHash<int, int> positions;
+    
+    // Convex hull of the points not removed, to be built again if "stale" is true, and the ids of its vertexes
+    group_hull hull;
+    QSet<int> hull_ids;
+    bool stale;
+};
+
+// Convex hull of a set of points from which points can be both inserted and removed, as for a sliding window. The points are
+// kept in O(log n) buckets, and the bucket k has at most 2^k points (Bentley-Saxe): an insertion merges the full buckets
+// 0 .. k-1 into the empty bucket k, like a binary counter, and builds its convex hull with Quickhull, so each point takes part
+// in O(log n) builds. A removal only marks the point as removed: the convex hull of its bucket is built again at the next query
+// if the point was one of its vertexes, and the bucket is rebuilt with the points left when more than half of them are removed.
+// Extreme point queries walk the convex hull of each bucket; containment queries and get_convex_hull() use the convex hull of
+// all the points, which is updated lazily when it is queried: the points inserted since the last query are merged with its
+// vertexes, and it is built again from the vertexes of the buckets only when one of its own vertexes has been removed.
+class dynamic_hull
+{
+    public:
+        
+        dynamic_hull();
+        
+        // Insert a point, and return the id to remove it
+        int insert(const vertex &point);
+        
+        // Remove the point with the given id. Return false if there is no such point.
+        bool remove(int point_id);
+        
+        // Number of points not removed
+        int size() const;
+        
+        // Find in "extreme" the point farthest along "direction". Return false if there are no points.
+        bool extreme_point(const double direction[3], vertex &extreme);
+        
+        // Return true if the point is inside the convex hull or on its boundary. If the points don't span a volume, return false.
+        bool contains(const vertex &point);
+        
+        // Copy the convex hull of the points in "convex_hull". Return false if the points don't span a volume.
+        bool get_convex_hull(DCEL &convex_hull);
+        
+    private:
+        
+        void fill_bucket(int level, QVector<int> &ids, QVector<vertex> &points);
+        void take_points(int level, QVector<int> &ids, QVector<vertex> &points);
+        void update_bucket_hull(int level);
+        bool update_convex_hull(void);
+        bool hull_contains(const vertex &point);
+        
+        QVector<dynamic_bucket> buckets;
+        
+        // Bucket of each point, from its id
+        QHash<int, int> point_level;
+        int next_id;
+        
+        // Convex hull of all the points, valid if "hull_changed" is false once the points in "inserted" are merged with it,
+        // and the ids of its vertexes. The points inserted since the last update are found from their id.
+        DCEL hull;
+        QSet<int> hull_ids;
+        QHash<int, vertex> inserted;
+        bool hull_changed;
+        bool hull_built;
+};
+
+#endif // DYNAMIC_HULL_H
@@ -0,0 +1,62 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "edge_index.h"
+
+void edge_index::clear(void)
+{
+    edges.clear();
+}
+
+void edge_index::reserve(int edges_n)
+{
+    edges.reserve(edges_n);
+}
+
+void edge_index::insert(int from_vertex, int to_vertex, int half_edge_id)
+{
+    edges.insert(key(from_vertex, to_vertex), half_edge_id);
+}
+
+int edge_index::take(int from_vertex, int to_vertex)
+{
+    QHash<quint64, int>::iterator edge = edges.find(key(from_vertex, to_vertex));
+    
+    if (edge == edges.end()) {
+        
+        return -1;
+    }
+    
+    int half_edge_id = edge.value();
+    edges.erase(edge);
+    
+    return half_edge_id;
+}
+
+int edge_index::size(void) const
+{
+    return edges.size();
+}
+
+// Pack the two vertexes in one key
+quint64 edge_index::key(int from_vertex, int to_vertex)
+{
+    return ((quint64)(quint32)from_vertex << 32) | (quint32)to_vertex;
+}
@@ -0,0 +1,50 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EDGE_INDEX_H
+#define EDGE_INDEX_H
+
+#include <QHash>
+
+// Index of the half-edges still waiting for their twin, by their "from" and "to" vertexes. A half-edge looks for the
+// opposite one (to, from) in O(1): if it is found they are twins and it is removed, else the half-edge is inserted.
+class edge_index
+{
+    public:
+        
+        void clear(void);
+        void reserve(int edges_n);
+        
+        // Insert the half-edge "half_edge_id" from "from_vertex" to "to_vertex"
+        void insert(int from_vertex, int to_vertex, int half_edge_id);
+        
+        // Remove the half-edge from "from_vertex" to "to_vertex" from the index and return it, or -1 if there isn't
+        int take(int from_vertex, int to_vertex);
+        
+        int size(void) const;
+        
+    private:
+        
+        static quint64 key(int from_vertex, int to_vertex);
+        
+        QHash<quint64, int> edges;
+};
+
+#endif // EDGE_INDEX_H
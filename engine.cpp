@@ -21,9 +21,30 @@
 #include "engine.h"
 #include <assert.h>
 #include "timer.h"
+#include "incremental_hull.h"
+#include "quickhull.h"
+#include "divide_conquer_hull.h"
+#include "chan_hull.h"
+#include "interior_culling.h"
+#include "duplicate_removal.h"
+#include "epsilon_kernel.h"
+#include "edge_index.h"
+#include <sstream>
+#include <algorithm>
+#include <QtConcurrentMap>
 
 Engine::Engine(QObject *parent) : QObject(parent)
 {
+	algorithm = INCREMENTAL;
+	cull_interior = false;
+	remove_duplicates = false;
+	duplicate_tolerance = 0;
+	single_conflict = false;
+	spatial_order = false;
+	streaming_chunk = 0;
+	approximation = 0;
+	all_meshes = false;
+	union_hull = false;
 	reset();
 }
 
@@ -32,502 +53,282 @@ void Engine::reset(void)
 {
 	state = INPUT;
 	meshes.clear();
+	loaded_meshes.clear();
 }
 
 
-void Engine::calculate_ch(void)
+bool Engine::calculate_ch(void)
 {
-	Timer timer("3D Convex Hull");
+    if (all_meshes || union_hull) {
+        
+        return calculate_hulls(loaded_meshes);
+    }
+    
+    if (meshes.isEmpty() || meshes[0].get_vertex_n() < STARTING_POINTS) {
+        
+        std::cout << "At least " << STARTING_POINTS << " points are needed to compute the convex hull" << std::endl;
+        return false;
+    }
     
-    srand (time(NULL));
+	Timer timer("3D Convex Hull");
     
     DCEL convex_hull;
     
     // Get all the vertex from the mesh
-    QVector<vertex> vertex_list = meshes[0].get_all_vertexes();
+    if (!compute_hull(meshes[0].get_all_vertexes(), convex_hull, 0, std::cout)) {
+        
+        return false;
+    }
+    
+    meshes.push_back(convex_hull);
+    send_dcel(meshes);
+
+	timer.stop_and_print();
+    
+    return true;
+}
+
+// Compute the convex hulls of the selected meshes at the same time, each one in its own thread, and append them in the
+// order of the selection. With the union option, the convex hull of all the vertexes of these convex hulls, which is the
+// convex hull of the union of the meshes, is appended last.
+bool Engine::calculate_hulls(QVector<int> selection)
+{
+    if (selection.isEmpty()) {
+        
+        std::cout << "No mesh to compute the convex hull of" << std::endl;
+        return false;
+    }
     
-    // Shuffle the vertexes in the list
-    random_shuffle(vertex_list.begin(), vertex_list.end());
+    for (int i = 0; i < selection.size(); i++) {
+        
+        if (selection[i] < 0 || selection[i] >= meshes.size() || meshes[selection[i]].get_vertex_n() < STARTING_POINTS) {
+            
+            std::cout << "At least " << STARTING_POINTS << " points are needed to compute the convex hull of each mesh" << std::endl;
+            return false;
+        }
+    }
     
-    // Find the first four points to obtain a tethraedron
-    int vert0, vert1, vert2, vert3;
-    int v0, v1, v2, v3;
-    vertex vertex0, vertex1, vertex2, vertex3;
+	Timer timer("3D Convex Hull");
     
-    // Get the first point
-    vert0 = rand() % vertex_list.size();
-    v0 = convex_hull.add_vertex(vertex_list[vert0]);
-    vertex0 = convex_hull.get_vertex(v0);
-    swap_vertex(vertex_list, 0, vert0);
+    QVector<mesh_hull_job> jobs(selection.size());
     
-    // Get the second point
-    do {
+    for (int i = 0; i < selection.size(); i++) {
         
-        vert1 = rand() % vertex_list.size();
-    } while (vert0 == vert1);
+        jobs[i].engine = this;
+        jobs[i].vertex_list = meshes[selection[i]].get_all_vertexes();
+        jobs[i].seed = i;
+    }
     
-    v1 = convex_hull.add_vertex(vertex_list[vert1]);
-    vertex1 = convex_hull.get_vertex(v1);
-    swap_vertex(vertex_list, 1, vert1);
+    QtConcurrent::blockingMap(jobs, compute_job);
     
-    // Get the third point
-    while (convex_hull.get_vertex_n() < 3) {
+    bool computed = true;
+    QVector<vertex> union_vertexes;
+    
+    for (int i = 0; i < jobs.size(); i++) {
+        
+        std::cout << jobs[i].log;
         
-        do {
+        if (jobs[i].computed) {
             
-            vert2 = rand() % vertex_list.size();
-        } while (vert0 == vert2 || vert1 == vert2);
-        vertex2 = vertex_list[vert2];
-                
-        // Check if the three point are colinear
-        double colinearity = vertex0.get_coord().getX() * (vertex1.get_coord().getY() - vertex2.get_coord().getY()) +
-                          vertex1.get_coord().getX() * (vertex2.get_coord().getY() - vertex0.get_coord().getY()) +
-                          vertex2.get_coord().getX() * (vertex0.get_coord().getY() - vertex1.get_coord().getY());
-                
-        // If they aren't colienar, then add the point to the convex hull, else choose another one
-        if (colinearity != 0) {
+            meshes.push_back(jobs[i].convex_hull);
+            union_vertexes += jobs[i].convex_hull.get_all_vertexes();
+        } else {
             
-            v2 = convex_hull.add_vertex(vertex2);
-            swap_vertex(vertex_list, 2, vert2);
+            computed = false;
         }
     }
     
-    double determinant;
-    
-    // Get the fourth point
-    while (convex_hull.get_vertex_n() < 4) {
+    // The vertexes of the convex hulls are the only points of the meshes which can be on the convex hull of their union
+    if (computed && union_hull) {
         
-        do {
-            
-            vert3 = rand() % vertex_list.size();
-        } while (vert0 == vert3 || vert1 == vert3 || vert2 == vert3);
-        vertex3 = vertex_list[vert3];
+        DCEL convex_hull;
         
-        // Check if the four points are coplanar
-        QMatrix4x4 coplanarity(vertex0.get_coord().getX(), vertex0.get_coord().getY(), vertex0.get_coord().getZ(), 1,
-                               vertex1.get_coord().getX(), vertex1.get_coord().getY(), vertex1.get_coord().getZ(), 1,
-                               vertex2.get_coord().getX(), vertex2.get_coord().getY(), vertex2.get_coord().getZ(), 1,
-                               vertex3.get_coord().getX(), vertex3.get_coord().getY(), vertex3.get_coord().getZ(), 1);
+        computed = compute_hull(union_vertexes, convex_hull, jobs.size(), std::cout);
         
-        determinant = coplanarity.determinant();
-        
-        if (determinant != 0) {
+        if (computed) {
             
-            v3 = convex_hull.add_vertex(vertex3);
-            swap_vertex(vertex_list, 3, vert3);
+            std::cout << "Convex hull of the union of " << jobs.size() << " meshes" << std::endl;
+            meshes.push_back(convex_hull);
         }
     }
     
-    // If the determinant is positive, the fourh point see the face in counterclockwise sense, and the face from outside would be in clockwise sense.
-    // So, if the determinant is positive, the tethraedron will be constructed with the points in the reverse order.
-    if (determinant > 0) {
+    send_dcel(meshes);
+
+	timer.stop_and_print();
+    
+    return computed;
+}
+
+// Run one of the jobs of calculate_hulls(), keeping its messages
+void Engine::compute_job(mesh_hull_job &job)
+{
+    std::ostringstream log;
+    
+    job.computed = job.engine->compute_hull(job.vertex_list, job.convex_hull, job.seed, log);
+    job.vertex_list.clear();
+    job.log = log.str();
+}
+
+// Compute the convex hull of "vertex_list" with the options of the engine, printing its messages on "log".
+// The randomized algorithms use "seed", so each hull is the same at every run. Only the elements on the convex hull are kept.
+bool Engine::compute_hull(QVector<vertex> vertex_list, DCEL &convex_hull, unsigned int seed, std::ostream &log)
+{
+    // Keep one point for each group of duplicates
+    if (remove_duplicates) {
         
-        create_tethraedron(convex_hull, v0, v2, v1, v3);
-    } else {
+        duplicate_removal duplicates;
+        int removed = duplicates.remove(vertex_list, duplicate_tolerance);
         
-        create_tethraedron(convex_hull, v0, v1, v2, v3);
+        log << removed << " duplicate points removed, " << vertex_list.size() << " left" << std::endl;
     }
-        
-    conflict_graph conf_graph;
     
-    // Add face nodes in the conflict graph for the tethraedron faces
-    for (int i = 0; i < convex_hull.get_faces_n(); i++) {
+    // Keep only the core-set of an approximate convex hull
+    if (approximation > 0) {
+        
+        epsilon_kernel kernel;
+        double bound = kernel.reduce(vertex_list, approximation);
         
-        conf_graph.add_face_node(i);
+        log << vertex_list.size() << " points kept in the core-set, Hausdorff distance at most " << bound << std::endl;
     }
     
-    // Check if each face of the tethraedron is visible from each vertex in the list
-    for (int i = STARTING_POINTS; i < vertex_list.size(); i++) {
+    // Discard the points which can't be on the convex hull
+    if (cull_interior) {
         
-        // Add a node in the conflict graph
-        conf_graph.add_vertex_node(i);
+        interior_culling culling;
+        int discarded = culling.cull(vertex_list);
         
-        for (int j = 0; j < convex_hull.get_faces_n(); j++) {
-            
-            // If the face is visible from the vertex, create an arch in the conflict grapf between them
-            if (is_face_visible(convex_hull, j, vertex_list[i])) {
-                
-                conf_graph.create_arch(j, i);
-            }
-        }
+        log << discarded << " interior points discarded, " << vertex_list.size() << " left" << std::endl;
     }
     
-    // For each point, check visible faces and replace them with new faces
-    for (int i = STARTING_POINTS; i < vertex_list.size(); i++) {
-        
-        // Obtain the list of visible faces from the vertex i
-        QVector<int> visible_faces = conf_graph.get_visible_faces(i);
+    hull_algorithm *hull = create_hull_algorithm(seed);
+    bool computed = hull->calculate(vertex_list, convex_hull);
+    delete hull;
+    
+    if (!computed) {
         
-        // If there are visible faces, then the vertex is outside the convex hull
-        if (visible_faces.size() > 0) {
-            
-            QVector<int> horizon_edges;
-            QVector<int> edges_to_set_twin;
-            QVector<int> vertex_to_check;
-            QVector<int> horizon_vertexes;
-            
-            // Add the vertex to convex hull
-            int new_vertex = convex_hull.add_vertex(vertex_list[i]);
-            
-            // Find horizon edges
-            check_horizon_edges(convex_hull, horizon_edges, horizon_vertexes, vertex_to_check, visible_faces);
-            
-            // Find vertexes to hide
-            check_vertex_to_hide(convex_hull, vertex_to_check, horizon_vertexes);
-            
-            // For each horizon edge, create a new face and check visibility
-            for (int j = 0; j < horizon_edges.size(); j++) {
-                
-                int horizon_edge = horizon_edges[j];
-                half_edge real_horizon_edge = convex_hull.get_half_edge(horizon_edge);
-                
-                int old_face = real_horizon_edge.get_face();
-                int old_face_twin = convex_hull.get_half_edge(real_horizon_edge.get_twin()).get_face();
-                
-                QVector<int> visible_vertexes = conf_graph.get_visible_vertexes(old_face);
-                QVector<int> visible_vertexes_help = conf_graph.get_visible_vertexes(old_face_twin);
-                
-                // Find the vertexes which could see the face incident to the horizon edge and the one incident on its twin
-                for (int k = 0; k < visible_vertexes_help.size(); k++) {
-                    
-                    if (!visible_vertexes.contains(visible_vertexes_help[k])) {
-                        
-                        visible_vertexes.append(visible_vertexes_help[k]);
-                    }
-                }
-                
-                // Create two new half-edges
-                int new_half_edge_1 = create_half_edge(convex_hull, real_horizon_edge.to_vertex, new_vertex);
-                int new_half_edge_2 = create_half_edge(convex_hull, new_vertex, real_horizon_edge.from_vertex);
-                
-                edges_to_set_twin.append(new_half_edge_1);
-                edges_to_set_twin.append(new_half_edge_2);
-                
-                // Set half-edges nexts
-                convex_hull.set_half_edge_next(horizon_edge, new_half_edge_1);
-                convex_hull.set_half_edge_next(new_half_edge_1, new_half_edge_2);
-                convex_hull.set_half_edge_next(new_half_edge_2, horizon_edge);
-                
-                // Create the new face
-                int new_face = create_face(convex_hull, horizon_edge);
-                
-                // Set the face visible in the convex hull
-                convex_hull.set_face_in_convex_hull(new_face, true);
-                
-                // Set half-edges' incident face
-                convex_hull.set_half_edge_face(horizon_edge, new_face);
-                convex_hull.set_half_edge_face(new_half_edge_1, new_face);
-                convex_hull.set_half_edge_face(new_half_edge_2, new_face);
-                
-                // Create a new node in the conflict graph for the new face
-                conf_graph.add_face_node(new_face);
-                
-                // Check the visibility of the new faces with the vertexes that we found before
-                for (int k = 0; k < visible_vertexes.size(); k++) {
-                    
-                    if (is_face_visible(convex_hull, new_face, vertex_list[visible_vertexes[k]])) {
-                        
-                        conf_graph.create_arch(new_face, visible_vertexes[k]);
-                    }
-                }
-            }
-            
-            // Check the new edges to set the correct twins
-            set_correct_twin(convex_hull, edges_to_set_twin);
-            
-            // Remove the old faces from the conflict graph
-            for (int j = 0; j < visible_faces.size(); j++) {
-                
-                conf_graph.remove_face_node(visible_faces[j]);
-            }
-            
-            // Remove the new vertex from the conflict graph
-            conf_graph.remove_vertex_node(new_vertex);
-        }
+        log << "The points don't span a volume, the convex hull can't be computed" << std::endl;
+        return false;
     }
-        
-    meshes.push_back(convex_hull);
-    send_dcel(meshes);
+    
+    // Drop the faces, half-edges and vertexes removed while building the convex hull
+    convex_hull.compact();
+    
+    return true;
+}
 
-	timer.stop_and_print();
+void Engine::set_algorithm(Algorithm a)
+{
+	algorithm = a;
 }
 
-// Swap two vertex in the vertex list
-void Engine::swap_vertex(QVector<vertex> &vertex_list, int vertex1, int vertex2)
+
+void Engine::set_interior_culling(bool cull)
 {
-    vertex tmp;
-    
-    tmp = vertex_list[vertex1];
-    vertex_list[vertex1] = vertex_list[vertex2];
-    vertex_list[vertex2] = tmp;
+	cull_interior = cull;
 }
 
-// Declare a new half-edge, set its next and from vertexes and insert it into the convex hull. Return the position of the half-edge in the convex hull.
-int Engine::create_half_edge(DCEL &convex_hull, int from_vertex, int to_vertex)
+
+void Engine::set_duplicate_removal(bool remove)
 {
-    half_edge new_half_edge;
-    new_half_edge.set_from_vertex(from_vertex);
-    new_half_edge.set_to_vertex(to_vertex);
-    
-    return convex_hull.add_half_edge(new_half_edge);
+	remove_duplicates = remove;
 }
 
-// Declare a new face, set its inner edge and insert it into the convex hull. Return the position of the face in the convex hull.
-int Engine::create_face(DCEL &convex_hull, int inner_edge)
+
+void Engine::set_duplicate_tolerance(double tolerance)
 {
-    face new_face;
-    new_face.set_inner_half_edge(inner_edge);
-    
-    return convex_hull.add_face(new_face);
+	duplicate_tolerance = tolerance;
 }
 
-// Create the tethraedron in the convex hull DCEL.
-void Engine::create_tethraedron(DCEL &convex_hull, int v0, int v1, int v2, int v3)
+
+void Engine::set_single_conflict(bool single)
 {
-    // Create edges and set their twins
-    int h0 = create_half_edge(convex_hull, v2, v1);
-    int h1 = create_half_edge(convex_hull, v1, v2);
-    convex_hull.set_half_edge_twin(h0, h1);
-    convex_hull.set_half_edge_twin(h1, h0);
-    
-    int h2 = create_half_edge(convex_hull, v2, v0);
-    int h3 = create_half_edge(convex_hull, v0, v2);
-    convex_hull.set_half_edge_twin(h2, h3);
-    convex_hull.set_half_edge_twin(h3, h2);
-    
-    int h4 = create_half_edge(convex_hull, v2, v3);
-    int h5 = create_half_edge(convex_hull, v3, v2);
-    convex_hull.set_half_edge_twin(h4, h5);
-    convex_hull.set_half_edge_twin(h5, h4);
-    
-    int h6 = create_half_edge(convex_hull, v1, v0);
-    int h7 = create_half_edge(convex_hull, v0, v1);
-    convex_hull.set_half_edge_twin(h6, h7);
-    convex_hull.set_half_edge_twin(h7, h6);
-    
-    int h8 = create_half_edge(convex_hull, v1, v3);
-    int h9 = create_half_edge(convex_hull, v3, v1);
-    convex_hull.set_half_edge_twin(h8, h9);
-    convex_hull.set_half_edge_twin(h9, h8);
-    
-    int h10 = create_half_edge(convex_hull, v0, v3);
-    int h11 = create_half_edge(convex_hull, v3, v0);
-    convex_hull.set_half_edge_twin(h10, h11);
-    convex_hull.set_half_edge_twin(h11, h10);
-    
-    // Set half-edges' nexts
-    convex_hull.set_half_edge_next(h0, h8);
-    convex_hull.set_half_edge_next(h8, h5);
-    convex_hull.set_half_edge_next(h5, h0);
-    
-    convex_hull.set_half_edge_next(h1, h2);
-    convex_hull.set_half_edge_next(h2, h7);
-    convex_hull.set_half_edge_next(h7, h1);
-    
-    convex_hull.set_half_edge_next(h6, h10);
-    convex_hull.set_half_edge_next(h10, h9);
-    convex_hull.set_half_edge_next(h9, h6);
-    
-    convex_hull.set_half_edge_next(h4, h11);
-    convex_hull.set_half_edge_next(h11, h3);
-    convex_hull.set_half_edge_next(h3, h4);
-    
-    // Create faces
-    int f0 = create_face(convex_hull, h0);
-    int f1 = create_face(convex_hull, h1);
-    int f2 = create_face(convex_hull, h6);
-    int f3 = create_face(convex_hull, h4);
-
-    convex_hull.set_face_in_convex_hull(f0, true);
-    convex_hull.set_face_in_convex_hull(f1, true);
-    convex_hull.set_face_in_convex_hull(f2, true);
-    convex_hull.set_face_in_convex_hull(f3, true);
-    
-    // Set half-edges' incident faces
-    convex_hull.set_half_edge_face(h0, f0);
-    convex_hull.set_half_edge_face(h1, f1);
-    convex_hull.set_half_edge_face(h2, f1);
-    convex_hull.set_half_edge_face(h3, f3);
-    convex_hull.set_half_edge_face(h4, f3);
-    convex_hull.set_half_edge_face(h5, f0);
-    convex_hull.set_half_edge_face(h6, f2);
-    convex_hull.set_half_edge_face(h7, f1);
-    convex_hull.set_half_edge_face(h8, f0);
-    convex_hull.set_half_edge_face(h9, f2);
-    convex_hull.set_half_edge_face(h10, f2);
-    convex_hull.set_half_edge_face(h11, f3);
+	single_conflict = single;
 }
 
-// Check if a face is visible from the vertex "point".
-bool Engine::is_face_visible(DCEL &convex_hull, int face_id, vertex &point)
+
+void Engine::set_spatial_order(bool spatial)
 {
-    face face_to_check = convex_hull.get_face(face_id);
-    
-    vertex vertex0, vertex1, vertex2;
-    
-    // Get the three vertex of the face
-    int h0 = face_to_check.get_inner_half_edge();
-    half_edge real_h0 = convex_hull.get_half_edge(h0);
-    vertex0 = convex_hull.get_vertex(real_h0.get_from_vertex());
-    
-    int h1 = real_h0.get_next();
-    half_edge real_h1 = convex_hull.get_half_edge(h1);
-    vertex1 = convex_hull.get_vertex(real_h1.get_from_vertex());
-    
-    int h2 = real_h1.get_next();
-    half_edge real_h2 = convex_hull.get_half_edge(h2);
-    vertex2 = convex_hull.get_vertex(real_h2.get_from_vertex());
-    
-    QMatrix4x4 visibility(vertex0.get_coord().getX(), vertex0.get_coord().getY(), vertex0.get_coord().getZ(), 1,
-                          vertex1.get_coord().getX(), vertex1.get_coord().getY(), vertex1.get_coord().getZ(), 1,
-                          vertex2.get_coord().getX(), vertex2.get_coord().getY(), vertex2.get_coord().getZ(), 1,
-                          point.get_coord().getX(), point.get_coord().getY(), point.get_coord().getZ(), 1);
-    
-    // Compute the determinant
-    double determinant = visibility.determinant();
-    
-    // If the determinant is positive, the face is visible
-    if (determinant > 0) {
-        
-        return true;
-    }
-    
-    return false;
+	spatial_order = spatial;
 }
 
-// Analyse all the visible faces to find horizon edges
-void Engine::check_horizon_edges(DCEL &convex_hull, QVector<int> &horizon_edges, QVector<int> &horizon_vertixes, QVector<int> &vertexes_to_check, QVector<int> &visible_faces)
+
+void Engine::set_streaming(int chunk_size)
 {
-    // For each visible face, analyse its half-edges to find horizon edges
-    for (int i = 0; i < visible_faces.size(); i++) {
-        
-        face face_to_check = convex_hull.get_face(visible_faces[i]);
-        
-        // Get the half-edges of the face
-        int h0 = face_to_check.get_inner_half_edge();
-        half_edge real_h0 = convex_hull.get_half_edge(h0);
-        
-        int h1 = real_h0.get_next();
-        half_edge real_h1 = convex_hull.get_half_edge(h1);
-        
-        int h2 = real_h1.get_next();
-        half_edge real_h2 = convex_hull.get_half_edge(h2);
-        
-        // Get the twins of the face's half-edges
-        half_edge h0_twin = convex_hull.get_half_edge(real_h0.get_twin());
-        half_edge h1_twin = convex_hull.get_half_edge(real_h1.get_twin());
-        half_edge h2_twin = convex_hull.get_half_edge(real_h2.get_twin());
-        
-        // Appends all face's vertexes to a list
-        vertexes_to_check.append(real_h0.get_from_vertex());
-        vertexes_to_check.append(real_h1.get_from_vertex());
-        vertexes_to_check.append(real_h2.get_from_vertex());
-        
-        // For each half-edges' twin, check if the incident face is in the list of the visible faces.
-        // If the face isn't in the list, then the half-edge is an horizon edge, and appends the vertexes to a list. Else, the edges has to be hidden.
-        if (!visible_faces.contains(h0_twin.get_face())) {
-            
-            horizon_edges.append(h0);
-            
-            if (!horizon_vertixes.contains(real_h0.get_from_vertex())) {
-                
-                horizon_vertixes.append(real_h0.get_from_vertex());
-            }
-            
-            if (!horizon_vertixes.contains(real_h0.get_to_vertex())) {
-                
-                horizon_vertixes.append(real_h0.get_to_vertex());
-            }
-        } else {
-            
-            convex_hull.set_half_edge_in_convex_hull(h0, false);
-        }
-        
-        if (!visible_faces.contains(h1_twin.get_face())) {
-            
-            horizon_edges.append(h1);
-            
-            if (!horizon_vertixes.contains(real_h1.get_from_vertex())) {
-                
-                horizon_vertixes.append(real_h1.get_from_vertex());
-            }
-            
-            if (!horizon_vertixes.contains(real_h1.get_to_vertex())) {
-                
-                horizon_vertixes.append(real_h1.get_to_vertex());
-            }
-        } else {
-            
-            convex_hull.set_half_edge_in_convex_hull(h1, false);
-        }
-        
-        
-        if (!visible_faces.contains(h2_twin.get_face())) {
-            
-            horizon_edges.append(h2);
-            
-            if (!horizon_vertixes.contains(real_h2.get_from_vertex())) {
-                
-                horizon_vertixes.append(real_h2.get_from_vertex());
-            }
-            
-            if (!horizon_vertixes.contains(real_h2.get_to_vertex())) {
-                
-                horizon_vertixes.append(real_h2.get_to_vertex());
-            }
-        } else {
-            
-            convex_hull.set_half_edge_in_convex_hull(h2, false);
-        }
-        
-        // Hide the face from convex hull
-        convex_hull.set_face_in_convex_hull(visible_faces[i], false);
-    }
+	streaming_chunk = chunk_size;
 }
 
-// Check visible faces' vertexes to find out the ones to be deleted.
-void Engine::check_vertex_to_hide(DCEL &convex_hull, QVector<int> &vertex_to_check, QVector<int> &horizon_vertexes)
+
+void Engine::set_all_meshes(bool all)
 {
-    // For each point to check
-    for (int i = 0; i < vertex_to_check.size(); i++) {
-        
-        // If the point isn't in the horizon, then hide it
-        if (!horizon_vertexes.contains(vertex_to_check[i])) {
-            
-            convex_hull.set_vertex_in_convex_hull(vertex_to_check[i], false);
-        }
-    }
+	all_meshes = all;
 }
 
-// For each edge, check the others to find his twin. Then, remove both from list.
-void Engine::set_correct_twin(DCEL &convex_hull, QVector<int> &half_edge_list)
+
+void Engine::set_union_hull(bool union_of_meshes)
 {
-    while (half_edge_list.size() != 0) {
-        
-        // Get the first edge
-        half_edge real_half_edge = convex_hull.get_half_edge(half_edge_list[0]);
-        
-        // Check the other vertex
-        for (int i = 1; i < half_edge_list.size(); i++) {
-            
-            half_edge half_edge_to_check = convex_hull.get_half_edge(half_edge_list[i]);
-            
-            // If they have from and to vertexes inverted, then they are twins
-            if (real_half_edge.get_from_vertex() == half_edge_to_check.get_to_vertex() &&
-                real_half_edge.get_to_vertex() == half_edge_to_check.get_from_vertex()) {
-                
-                // Set them as twins
-                convex_hull.set_half_edge_twin(half_edge_list[0], half_edge_list[i]);
-                convex_hull.set_half_edge_twin(half_edge_list[i], half_edge_list[0]);
-                
-                // Remove them from list
-                half_edge_list.remove(i);
-                half_edge_list.remove(0);
-                
-                break;
-            }
-        }
-    }
+	union_hull = union_of_meshes;
+}
+
+
+void Engine::set_approximation(double epsilon)
+{
+	approximation = epsilon;
+}
+
+
+void Engine::set_incremental(void)
+{
+	set_algorithm(INCREMENTAL);
+}
+
+
+void Engine::set_quickhull(void)
+{
+	set_algorithm(QUICKHULL);
+}
+
+
+void Engine::set_divide_and_conquer(void)
+{
+	set_algorithm(DIVIDE_AND_CONQUER);
+}
+
+
+void Engine::set_chan(void)
+{
+	set_algorithm(CHAN);
+}
+
+
+// Create the object which computes the convex hull with the selected algorithm, seeding its random order with "seed".
+// It has to be deleted by the caller.
+hull_algorithm *Engine::create_hull_algorithm(unsigned int seed)
+{
+	if (algorithm == QUICKHULL) return new quickhull();
+	if (algorithm == DIVIDE_AND_CONQUER) return new divide_conquer_hull();
+	if (algorithm == CHAN) return new chan_hull();
+
+	incremental_hull *incremental = new incremental_hull();
+	incremental->set_single_conflict(single_conflict);
+	incremental->set_spatial_order(spatial_order);
+	incremental->set_seed(seed);
+
+	return incremental;
+}
+
+
+// Return the vertexes of the convex hull of "vertex_list", computed with Quickhull, which also detects the
+// chunks whose points don't span a volume: none of them can be discarded, and they are all returned.
+QVector<vertex> Engine::hull_vertexes(QVector<vertex> vertex_list)
+{
+	DCEL convex_hull;
+	quickhull hull;
+
+	if (!hull.calculate(vertex_list, convex_hull)) return vertex_list;
+
+	convex_hull.compact();
+
+	return convex_hull.get_all_vertexes();
 }
 
 
@@ -539,12 +340,27 @@ void Engine::open_file(void)
 
 	if (!filename.isNull())
 	{
-		if(!create_from_file(filename)) return;
-		state = COMPUTED;
+		load_file(filename);
 	}
 }
 
 
+// Call the OFF loader on a given file, without any dialog
+//
+bool Engine::load_file(QString filename)
+{
+	if (streaming_chunk > 0)
+	{
+		if (!stream_from_file(filename)) return false;
+	}
+	else if(!create_from_file(filename)) return false;
+	state = COMPUTED;
+	loaded_meshes.append(meshes.size() - 1);
+
+	return true;
+}
+
+
 // Save a DCEL object to a .off file. This may be useful if you want to store
 // your convex hulls into the file system...
 //
@@ -558,40 +374,68 @@ void Engine::save_file(void)
 	
 	if (saveDialog.exec())
 	{
-		QString filename = saveDialog.selectedFiles().takeFirst();
+		write_file(saveDialog.selectedFiles().takeFirst());
+	}
+}
+
+
+// Write the last DCEL to a .off file. Only the elements which are still in the
+// convex hull are written, so the vertexes are renumbered.
+//
+bool Engine::write_file(QString filename)
+{
+	if (meshes.isEmpty()) return false;
+
+	QFile file(filename);
+
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+	{
+		std::cout << "Error saving file " << file.error() << std::endl;
+		return false;
+	}
+
+	QTextStream out(&file);
 	
-		QFile file(filename);
+	int last = meshes.size() - 1;
+	int nv = 0, nf = 0;
 
-		if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
-		{
-			std::cout << "Error saving file " << file.error() << std::endl;
-			return;
-		}
+	// New index of each vertex in the file, -1 if the vertex is not written
+	QVector<int> vertex_index(meshes[last].get_vertex_n(), -1);
 
-		QTextStream out(&file);
-		
-		out << "OFF\n";
-		
-		int last = meshes.size() - 1;
-		int nv = meshes[last].get_vertex_n(), nf = meshes[last].get_faces_n();
-		out << nv << " " << nf << " 0\n";
+	for(int i=0; i<meshes[last].get_vertex_n(); i++)
+	{
+		if (meshes[last].is_vertex_in_convex_hull(i)) vertex_index[i] = nv++;
+	}
 
-		for(int i=0; i<nv; i++)
-		{
-			CGPointf v = meshes[last].get_vertex(i).get_coord();
-			out << v.x << " " << v.y << " " << v.z << "\n";
-		}
+	for(int i=0; i<meshes[last].get_faces_n(); i++)
+	{
+		if (meshes[last].is_face_in_convex_hull(i)) nf++;
+	}
 
-		for(int i=0; i<nf; i++)
-		{
-			int v1, v2, v3, h;
-			h = meshes[last].get_face(i).get_inner_half_edge();
-			v1 = meshes[last].get_half_edge(h).get_from_vertex();
-			v2 = meshes[last].get_half_edge(h).get_to_vertex();
-			v3 = meshes[last].get_half_edge(meshes[last].get_half_edge(h).get_next()).get_to_vertex();
-			out << "3 " << v1 << " " << v2 << " " << v3 << "\n";
-		}
+	out << "OFF\n";
+	out << nv << " " << nf << " 0\n";
+
+	for(int i=0; i<meshes[last].get_vertex_n(); i++)
+	{
+		if (vertex_index[i] == -1) continue;
+
+		CGPointf v = meshes[last].get_vertex(i).get_coord();
+		out << v.x << " " << v.y << " " << v.z << "\n";
+	}
+
+	for(int i=0; i<meshes[last].get_faces_n(); i++)
+	{
+		if (!meshes[last].is_face_in_convex_hull(i)) continue;
+
+		int v1, v2, v3, h;
+		h = meshes[last].get_face(i).get_inner_half_edge();
+		v1 = meshes[last].get_half_edge(h).get_from_vertex();
+		v2 = meshes[last].get_half_edge(h).get_to_vertex();
+		v3 = meshes[last].get_half_edge(meshes[last].get_half_edge(h).get_next()).get_to_vertex();
+		out << "3 " << vertex_index[v1] << " " << vertex_index[v2] << " " << vertex_index[v3] << "\n";
 	}
+
+	return true;
 }
 
 
@@ -663,7 +507,9 @@ bool Engine::create_from_file(QString filename)
 		meshes[last].add_vertex( v );
 	}
 
-	QVector<QVector<QPair<int, int> > > record_table(nv);
+	// half-edges still without twin, by their vertexes
+	edge_index open_edges;
+	open_edges.reserve(nf * 3 / 2);
 
 	//
 	// load facets
@@ -695,6 +541,7 @@ bool Engine::create_from_file(QString filename)
 		he2.set_from_vertex( v2 );
 		he2.set_to_vertex( v3 );
 		he3.set_from_vertex( v3 );
+		he3.set_to_vertex( v1 );
 
 		he1_id = meshes[last].add_half_edge( he1 );
 		he2_id = meshes[last].add_half_edge( he2 );
@@ -707,115 +554,29 @@ bool Engine::create_from_file(QString filename)
 		meshes[last].set_half_edge_next( he2_id, he3_id );
 		meshes[last].set_half_edge_next( he3_id, he1_id );
 
-		QVector<QPair<int,int> > list = record_table.at(v2);
+		//
+		// set twins: each half-edge looks for the opposite one, else it waits for it in the index
+		//
 
-		int position = -1;
-		for(int seek=0; seek<list.size(); seek++)
-		{
-			QPair<int,int> record = list.at(seek);
-			if( record.first == v1 ) //v2->v1 messo
-			{
-				position = seek;
-				seek = list.size()+1;				
-			}
-		}
+		int he_ids[3] = { he1_id, he2_id, he3_id };
+		int from[3] = { v1, v2, v3 };
+		int to[3] = { v2, v3, v1 };
 
-		if( position != -1 )
-		{
-			//recupera record
-			QPair<int,int> record = list.at(position);
-			int twin_id = record.second;
-			//setta twin (v2->v1)
-			meshes[last].set_half_edge_twin( twin_id, he1_id );
-			meshes[last].set_half_edge_twin( he1_id, twin_id );
-			//rimuovi elemento
-			list.remove(position);
-			record_table.replace(v2, list);
-		}
-		else
+		for( int j=0; j < 3; j++ )
 		{
-			//list diventa la lista per v1 (aggiungiamo v1->v2)
-			list = record_table.at(v1);
-			//creiamo il record v1->v2
-			QPair<int,int> record( v2, he1_id );
-			list.push_back(record);
-			record_table.replace(v1, list);
-		}
-
-		//PER V2->V3
-		list = record_table.at(v3);
+			int twin_id = open_edges.take( to[j], from[j] );
 
-		//cercare v2 in list
-		position = -1;
-		for(int seek=0; seek<list.size(); seek++)
-		{
-			QPair<int,int> record = list.at(seek);
-			if( record.first == v2 ) //v3->v2 messo
+			if( twin_id != -1 )
 			{
-				position = seek;
-				seek = list.size()+1;				
+				meshes[last].set_half_edge_twin( twin_id, he_ids[j] );
+				meshes[last].set_half_edge_twin( he_ids[j], twin_id );
 			}
-		}
-
-		if( position != -1 )
-		{
-			//recupera record
-			QPair<int,int> record = list.at(position);
-			int twin_id = record.second;
-			//setta twin (v3->v2)
-			meshes[last].set_half_edge_twin( twin_id, he2_id );
-			meshes[last].set_half_edge_twin( he2_id, twin_id );
-			//rimuovi elemento
-			list.remove(position);
-			record_table.replace(v3, list);
-		}
-		else
-		{
-			//list diventa la lista per v2 (aggiungiamo v2->v3)
-			list = record_table.at(v2);
-			//creiamo il record v2->v3
-			QPair<int,int> record( v3, he2_id );
-			list.push_back(record);
-			record_table.replace(v2, list);
-		}
-
-		//PER V3->V1
-		list = record_table.at(v1);
-
-		//cercare v3 in list
-		position = -1;
-		for(int seek=0; seek<list.size(); seek++)
-		{
-			QPair<int,int> record = list.at(seek);
-			if( record.first == v3 ) //v1->v3 messo
+			else
 			{
-				position = seek;
-				seek = list.size()+1;				
+				open_edges.insert( from[j], to[j], he_ids[j] );
 			}
 		}
 
-		if( position != -1 )
-		{
-			//recupera record
-			QPair<int,int> record = list.at(position);
-			int twin_id = record.second;
-			//setta twin (v1->v3)
-			meshes[last].set_half_edge_twin( twin_id, he3_id );
-			meshes[last].set_half_edge_twin( he3_id, twin_id );
-			//rimuovi elemento
-			list.remove(position);
-			record_table.replace(v1, list);
-		}
-		else
-		{
-			//list diventa la lista per v3 (aggiungiamo v3->v1)
-			list = record_table.at(v3);
-			//creiamo il record v3->v1
-			QPair<int,int> record( v1, he3_id );
-			list.push_back(record);
-			record_table.replace(v3, list);
-		}
-
 		if( meshes[last].get_vertex( v1 ).get_incident_half_edge() == -1 ) meshes[last].set_vertex_incident( v1, he1_id );
 		if( meshes[last].get_vertex( v2 ).get_incident_half_edge() == -1 ) meshes[last].set_vertex_incident( v2, he2_id );
 		if( meshes[last].get_vertex( v3 ).get_incident_half_edge() == -1 ) meshes[last].set_vertex_incident( v3, he3_id );
@@ -881,3 +642,92 @@ bool Engine::create_from_file(QString filename)
 
     return true;
 }
+
+
+// Read the vertexes of a .off file in chunks of "streaming_chunk" points, and keep only the vertexes of the
+// convex hull of each chunk: a point inside the convex hull of a chunk is inside the convex hull of the file.
+// When the kept vertexes grow over twice their number after the last reduction (and over a chunk), they are
+// reduced to their own convex hull in the same way: each reduction at least halves the vertexes, or doubles the
+// next threshold, so the reductions cost O(h) amortized for each chunk and the memory stays O(chunk + h). The facets aren't read, and
+// the mesh gets only the vertexes left, which calculate_ch() merges into the final convex hull.
+//
+bool Engine::stream_from_file(QString filename)
+{
+	int nv, // number of vertices
+	    nh, // number of half-edges
+	    nf; // number of facets
+
+	DCEL tmp_d;
+	meshes.push_back(tmp_d);
+	int last = meshes.size() - 1;
+
+	std::cout << meshes.size() << " models loaded" << std::endl;
+
+	QFile file(filename);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return false;
+
+	QByteArray line = file.readLine();
+	char t[5];
+
+	int res = sscanf(line.data(), "%4s", t);
+	if (res != 1 || strcmp(t, "OFF"))
+	{
+		std::cout << res << " element read, first is " << t << std::endl;
+		return false;
+	}
+
+	line = file.readLine();
+	res = sscanf(line.data(), "%d %d %d", &nv, &nf, &nh);
+	if( res < 2 )
+	{
+		std::cout << "ERROR IN SECOND LINE (expected nv nf [ne])" << std::endl;
+		return false;
+	}
+
+	QVector<vertex> chunk;
+	QVector<vertex> kept;
+	int reduce_at = streaming_chunk;	// size of the kept vertexes which triggers their reduction
+	chunk.reserve(streaming_chunk);
+
+	for( int i=0; i < nv; i++ )
+	{
+		float x, y, z;
+
+		line = file.readLine();
+		res = sscanf(line.data(), "%f %f %f", &x, &y, &z);
+
+		if( res != 3 )
+		{
+			std::cout << "Error in vertex " << i << ": " << res << " elements read, first is " << x << std::endl;
+			return false;
+		}
+
+		vertex v;
+		v.set_coord( CGPointf( x, y, z ) );
+		v.set_incident_half_edge( -1 );
+		chunk.append( v );
+
+		if (chunk.size() == streaming_chunk || i == nv - 1)
+		{
+			kept += hull_vertexes(chunk);
+			chunk.clear();
+
+			if (kept.size() > reduce_at)
+			{
+				kept = hull_vertexes(kept);
+				reduce_at = std::max(streaming_chunk, 2 * kept.size());
+			}
+		}
+	}
+
+	for (int i = 0; i < kept.size(); i++)
+	{
+		meshes[last].add_vertex(kept[i]);
+	}
+
+	std::cout << nv << " points streamed, " << kept.size() << " kept" << std::endl;
+
+	emit send_dcel(meshes);
+
+	return true;
+}
@@ -22,6 +22,7 @@
 #include <stdlib.h>
 #include <iostream>
 #include <cmath>
+#include <string>
 
 #include <QtGui>
 #include <QFile>
@@ -29,12 +30,25 @@
 #include <QByteArray>
 
 #include "dcel/DCEL.hh"
-#include "conflict_graph.h"
-
-#define STARTING_POINTS 4
+#include "hull_algorithm.h"
 
 enum State { INPUT, COMPUTED };
 
+enum Algorithm { INCREMENTAL, QUICKHULL, DIVIDE_AND_CONQUER, CHAN };
+
+class Engine;
+
+// Convex hull of one of the meshes computed in parallel by calculate_hulls(), with the messages printed after all of them
+struct mesh_hull_job
+{
+	Engine *engine;
+	QVector<vertex> vertex_list;
+	DCEL convex_hull;
+	unsigned int seed;
+	bool computed;
+	std::string log;
+};
+
 class Engine : public QObject
 {
 
@@ -45,6 +59,13 @@ class Engine : public QObject
 
                 Engine(QObject *parent = 0);
 
+		bool load_file(QString filename);	// load a .off file without the open dialog
+		bool write_file(QString filename);	// write the last mesh to a .off file without the save dialog
+
+		void set_algorithm(Algorithm a);	// algorithm used by calculate_ch
+
+		bool calculate_hulls(QVector<int> selection);	// compute in parallel the convex hulls of the meshes in "selection"
+
 
 
 	signals:
@@ -58,7 +79,7 @@ class Engine : public QObject
 		void reset(void);
 		void open_file(void);
 		void save_file(void);
-		void calculate_ch(void);		// <= you are expected to fill this method in with
+		bool calculate_ch(void);		// <= you are expected to fill this method in with
 						//    the 3D Convex Hull Algorithm.
 						//
 						//    Every new variable/method/class is welcome as
@@ -70,24 +91,42 @@ class Engine : public QObject
 						//    class; if you want to add a functionality to this
 						//    class think if that should be either public or private...)
 
+		void set_incremental(void);
+		void set_quickhull(void);
+		void set_divide_and_conquer(void);
+		void set_chan(void);
+		void set_interior_culling(bool cull);		// discard the interior points before computing the convex hull
+		void set_duplicate_removal(bool remove);	// remove the duplicate points before computing the convex hull
+		void set_duplicate_tolerance(double tolerance);	// side of the grid cells whose points are duplicates (0 for the exact ones)
+		void set_single_conflict(bool single);		// keep one visible face per point in the incremental algorithm
+		void set_spatial_order(bool spatial);		// insert the points of the incremental algorithm in random rounds sorted along a Morton curve
+		void set_streaming(int chunk_size);		// load the files in chunks of points, keeping only their convex hull vertexes (0 to load them whole)
+		void set_all_meshes(bool all);			// compute the convex hull of every loaded mesh, not only of the first one
+		void set_union_hull(bool union_of_meshes);	// also compute the convex hull of the union of the loaded meshes
+		void set_approximation(double epsilon);	// compute a convex hull within epsilon times the diagonal of the bounding box (0 for the exact one)
+
 
 	private:
 
         bool create_from_file(QString filename);
+        bool stream_from_file(QString filename);
         
-        void swap_vertex(QVector<vertex> &vertex_list, int vertex1, int vertex2);
-        
-        int create_half_edge(DCEL &convex_hull, int from_vertex, int to_vertex);
-        int create_face(DCEL &convex_hull, int inner_edge);
-        void create_tethraedron(DCEL &convex_hull, int v0, int v1, int v2, int v3);
-        
-        bool is_face_visible(DCEL &convex_hull, int face_id, vertex &point);
-        
-        void check_horizon_edges(DCEL &convex_hull, QVector<int> &horizon_edges, QVector<int> &horizon_vertixes, QVector<int> &vertexes_to_check, QVector<int> &visible_faces);
-        void check_vertex_to_hide(DCEL &convex_hull, QVector<int> &vertex_to_check, QVector<int> &horizon_vertexes);
-        
-        void set_correct_twin(DCEL &convex_hull, QVector<int> &half_edge_list);
+        hull_algorithm *create_hull_algorithm(unsigned int seed);
+        bool compute_hull(QVector<vertex> vertex_list, DCEL &convex_hull, unsigned int seed, std::ostream &log);
+        static void compute_job(mesh_hull_job &job);
+        QVector<vertex> hull_vertexes(QVector<vertex> vertex_list);
         
 		State state;
+		Algorithm algorithm;
+		bool cull_interior;
+		bool remove_duplicates;
+		double duplicate_tolerance;
+		bool single_conflict;
+		bool spatial_order;
+		int streaming_chunk;
+		double approximation;
+		bool all_meshes;
+		bool union_hull;
+		QVector<int> loaded_meshes;	// positions of the meshes loaded from files, the others are convex hulls
 		QVector<DCEL> meshes;
 };
@@ -0,0 +1,189 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "epsilon_kernel.h"
+#include <cmath>
+#include <algorithm>
+#include "hull_algorithm.h"
+
+// Coordinate of "p" along the axis 0, 1 or 2
+static inline double coordinate(const CGPointf &p, int axis)
+{
+    return axis == 0 ? p.x : (axis == 1 ? p.y : p.z);
+}
+
+double epsilon_kernel::reduce(QVector<vertex> &vertex_list, double epsilon)
+{
+    int points_n = vertex_list.size();
+    
+    if (points_n == 0 || epsilon <= 0) {
+        
+        return 0;
+    }
+    
+    // Bounding box of the points
+    double min[3], max[3];
+    
+    for (int k = 0; k < 3; k++) {
+        
+        min[k] = max[k] = coordinate(vertex_list.at(0).coord, k);
+    }
+    
+    for (int i = 1; i < points_n; i++) {
+        
+        for (int k = 0; k < 3; k++) {
+            
+            double c = coordinate(vertex_list.at(i).coord, k);
+            
+            min[k] = std::min(min[k], c);
+            max[k] = std::max(max[k], c);
+        }
+    }
+    
+    // The columns run along the longest axis, so the other two get the fewest cells
+    int axis = 0;
+    double diagonal = 0;
+    
+    for (int k = 0; k < 3; k++) {
+        
+        diagonal += (max[k] - min[k]) * (max[k] - min[k]);
+        
+        if (max[k] - min[k] > max[axis] - min[axis]) {
+            
+            axis = k;
+        }
+    }
+    
+    diagonal = std::sqrt(diagonal);
+    
+    int u = (axis + 1) % 3;
+    int v = (axis + 2) % 3;
+    
+    // The diagonal of a square cell is sqrt(2) times its side
+    double cell = epsilon * diagonal / std::sqrt(2.0);
+    
+    if (cell <= 0) {
+        
+        return 0;
+    }
+    
+    double cells_u = std::max(1.0, std::ceil((max[u] - min[u]) / cell));
+    double cells_v = std::max(1.0, std::ceil((max[v] - min[v]) / cell));
+    
+    // With two points kept per column, a grid this fine can't drop anything
+    if (2 * cells_u * cells_v >= points_n) {
+        
+        return 0;
+    }
+    
+    int columns_u = (int)cells_u;
+    int columns_v = (int)cells_v;
+    
+    // Column of every point, with its lowest and highest point
+    QVector<int> column(points_n);
+    QVector<int> lowest(columns_u * columns_v, -1);
+    QVector<int> highest(columns_u * columns_v, -1);
+    
+    for (int i = 0; i < points_n; i++) {
+        
+        const CGPointf &p = vertex_list.at(i).coord;
+        
+        int cu = std::min((int)((coordinate(p, u) - min[u]) / cell), columns_u - 1);
+        int cv = std::min((int)((coordinate(p, v) - min[v]) / cell), columns_v - 1);
+        int c = cu * columns_v + cv;
+        
+        column[i] = c;
+        
+        if (lowest[c] == -1) {
+            
+            lowest[c] = highest[c] = i;
+        }
+        else if (coordinate(p, axis) < coordinate(vertex_list.at(lowest[c]).coord, axis)) {
+            
+            lowest[c] = i;
+        }
+        else if (coordinate(p, axis) > coordinate(vertex_list.at(highest[c]).coord, axis)) {
+            
+            highest[c] = i;
+        }
+    }
+    
+    // The bound achieved is the largest distance of a dropped point from the segment kept in its column
+    double bound = 0;
+    
+    for (int i = 0; i < points_n; i++) {
+        
+        int c = column[i];
+        
+        if (i != lowest[c] && i != highest[c]) {
+            
+            bound = std::max(bound, distance_from_segment(vertex_list.at(i).coord, vertex_list.at(lowest[c]).coord, vertex_list.at(highest[c]).coord));
+        }
+    }
+    
+    // Keep the lowest and highest points, in the order of the columns
+    QVector<vertex> core_set;
+    
+    for (int c = 0; c < lowest.size(); c++) {
+        
+        if (lowest[c] == -1) {
+            
+            continue;
+        }
+        
+        core_set.append(vertex_list.at(lowest[c]));
+        
+        if (highest[c] != lowest[c]) {
+            
+            core_set.append(vertex_list.at(highest[c]));
+        }
+    }
+    
+    // A core-set too small for a convex hull is useless
+    if (core_set.size() < STARTING_POINTS) {
+        
+        return 0;
+    }
+    
+    vertex_list = core_set;
+    
+    return bound;
+}
+
+// Distance of "p" from the segment between "a" and "b".
+double epsilon_kernel::distance_from_segment(const CGPointf &p, const CGPointf &a, const CGPointf &b)
+{
+    double ab[3] = {(double)b.x - a.x, (double)b.y - a.y, (double)b.z - a.z};
+    double ap[3] = {(double)p.x - a.x, (double)p.y - a.y, (double)p.z - a.z};
+    
+    double length = ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2];
+    double t = 0;
+    
+    if (length > 0) {
+        
+        t = std::max(0.0, std::min(1.0, (ap[0] * ab[0] + ap[1] * ab[1] + ap[2] * ab[2]) / length));
+    }
+    
+    double dx = ap[0] - t * ab[0];
+    double dy = ap[1] - t * ab[1];
+    double dz = ap[2] - t * ab[2];
+    
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
@@ -0,0 +1,45 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EPSILON_KERNEL_H
+#define EPSILON_KERNEL_H
+
+#include <QVector>
+#include "dcel/DCEL.hh"
+
+// Grid core-set for the approximate convex hull: the bounding box is cut into columns along its longest axis, and
+// only the lowest and the highest point of every column are kept. Every dropped point is inside its column, between
+// the two points kept there, so its distance from the convex hull of the core-set is at most the distance from the
+// segment joining them, which is bounded by the diagonal of the column section.
+class epsilon_kernel
+{
+    public:
+        
+        // Replace "vertex_list" with its core-set, whose convex hull is within "epsilon" times the diagonal of the
+        // bounding box from the convex hull of all the points. Return the distance bound actually achieved, measured
+        // on the dropped points, or 0 when no point is dropped.
+        double reduce(QVector<vertex> &vertex_list, double epsilon);
+        
+    private:
+        
+        double distance_from_segment(const CGPointf &p, const CGPointf &a, const CGPointf &b);
+};
+
+#endif // EPSILON_KERNEL_H
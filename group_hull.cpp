@@ -0,0 +1,122 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "group_hull.h"
+#include "quickhull.h"
+
+// Replace the points of the group with the vertexes of their convex hull, and find the neighbours of each vertex from the
+// half-edges leaving it.
+void build_group_hull(group_hull &group)
+{
+    DCEL convex_hull;
+    quickhull hull;
+    
+    group.start = 0;
+    group.flat = !hull.calculate(group.vertexes, convex_hull);
+    
+    if (group.flat) {
+        
+        return;
+    }
+    
+    convex_hull.compact();
+    
+    group.vertexes = convex_hull.get_all_vertexes();
+    group.first_neighbour.fill(0, group.vertexes.size() + 1);
+    group.neighbours.resize(convex_hull.get_half_edge_n());
+    
+    for (int i = 0; i < convex_hull.get_half_edge_n(); i++) {
+        
+        group.first_neighbour[convex_hull.get_half_edge(i).get_from_vertex() + 1]++;
+    }
+    
+    for (int i = 0; i < group.vertexes.size(); i++) {
+        
+        group.first_neighbour[i + 1] += group.first_neighbour[i];
+    }
+    
+    QVector<int> next_neighbour = group.first_neighbour;
+    
+    for (int i = 0; i < convex_hull.get_half_edge_n(); i++) {
+        
+        half_edge h = convex_hull.get_half_edge(i);
+        group.neighbours[next_neighbour[h.get_from_vertex()]++] = h.get_to_vertex();
+    }
+}
+
+// Distance of a point from "origin" along "direction", in floating point
+static inline double direction_distance(const double direction[3], const double origin[3], const CGPointf &point)
+{
+    return direction[0] * (point.x - origin[0]) + direction[1] * (point.y - origin[1]) + direction[2] * (point.z - origin[2]);
+}
+
+// Return the vertex of the group farthest along "direction", and its distance from "origin" along it in "distance".
+// On a convex polytope a vertex with no neighbour farther along a direction is the farthest vertex, so the query walks
+// from the last answer to the farthest neighbour until none is farther.
+int extreme_vertex(group_hull &group, const double direction[3], const double origin[3], double &distance)
+{
+    QVector<vertex> &vertexes = group.vertexes;
+    
+    // Scan all the points of a flat group
+    if (group.flat) {
+        
+        int farthest = 0;
+        distance = direction_distance(direction, origin, vertexes[0].coord);
+        
+        for (int i = 1; i < vertexes.size(); i++) {
+            
+            double candidate_distance = direction_distance(direction, origin, vertexes[i].coord);
+            
+            if (candidate_distance > distance) {
+                
+                farthest = i;
+                distance = candidate_distance;
+            }
+        }
+        
+        return farthest;
+    }
+    
+    int current = group.start;
+    distance = direction_distance(direction, origin, vertexes[current].coord);
+    
+    for (int next = current; ; current = next) {
+        
+        for (int i = group.first_neighbour[current]; i < group.first_neighbour[current + 1]; i++) {
+            
+            double candidate_distance = direction_distance(direction, origin, vertexes[group.neighbours[i]].coord);
+            
+            if (candidate_distance > distance) {
+                
+                next = group.neighbours[i];
+                distance = candidate_distance;
+            }
+        }
+        
+        if (next == current) {
+            
+            break;
+        }
+    }
+    
+    group.start = current;
+    
+    return current;
+}
@@ -0,0 +1,48 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GROUP_HULL_H
+#define GROUP_HULL_H
+
+#include <QVector>
+#include "dcel/DCEL.hh"
+
+// Convex hull of a group of points, kept for the extreme point queries: its vertexes and, for each of them, the list of
+// its neighbours, from first_neighbour[i] to first_neighbour[i + 1]. If the points of the group don't span a volume,
+// "flat" is true and all of them are kept, to be scanned one by one.
+struct group_hull
+{
+    QVector<vertex> vertexes;
+    QVector<int> first_neighbour;
+    QVector<int> neighbours;
+    bool flat;
+    
+    // Answer of the last query, where the next one starts from
+    int start;
+};
+
+// Replace the points of the group with the vertexes of their convex hull, computed with Quickhull
+void build_group_hull(group_hull &group);
+
+// Return the vertex of the group farthest along "direction", walking its convex hull from the answer of the last query.
+// The group mustn't be empty.
+int extreme_vertex(group_hull &group, const double direction[3], const double origin[3], double &distance);
+
+#endif // GROUP_HULL_H
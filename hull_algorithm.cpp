@@ -0,0 +1,490 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hull_algorithm.h"
+#include "point_block.h"
+#include "predicates.h"
+#include <cmath>
+
+hull_algorithm::hull_algorithm()
+{
+    stamp = 0;
+}
+
+hull_algorithm::~hull_algorithm()
+{
+}
+
+// Swap two vertex in the vertex list
+void hull_algorithm::swap_vertex(QVector<vertex> &vertex_list, int vertex1, int vertex2)
+{
+    vertex tmp;
+    
+    tmp = vertex_list[vertex1];
+    vertex_list[vertex1] = vertex_list[vertex2];
+    vertex_list[vertex2] = tmp;
+}
+
+// Declare a new half-edge, set its next and from vertexes and insert it into the convex hull. Return the position of the half-edge in the convex hull.
+int hull_algorithm::create_half_edge(DCEL &convex_hull, int from_vertex, int to_vertex)
+{
+    half_edge new_half_edge;
+    new_half_edge.set_from_vertex(from_vertex);
+    new_half_edge.set_to_vertex(to_vertex);
+    
+    return convex_hull.add_half_edge(new_half_edge);
+}
+
+// Declare a new face, set its inner edge and insert it into the convex hull. Return the position of the face in the convex hull.
+int hull_algorithm::create_face(DCEL &convex_hull, int inner_edge)
+{
+    face new_face;
+    new_face.set_inner_half_edge(inner_edge);
+    
+    // The nexts of the half-edges are already set, so the plane of the face can be computed once here
+    half_edge h0 = convex_hull.get_half_edge(inner_edge);
+    half_edge h1 = convex_hull.get_half_edge(h0.get_next());
+    
+    face_plane plane;
+    set_face_plane(plane, convex_hull.get_vertex(h0.get_from_vertex()).get_coord(), convex_hull.get_vertex(h1.get_from_vertex()).get_coord(),
+                   convex_hull.get_vertex(h1.get_to_vertex()).get_coord());
+    new_face.set_plane(plane);
+    
+    // The normal of the plane points outside, and normalized it is used for the flat shading
+    double length = sqrt(plane.normal[0] * plane.normal[0] + plane.normal[1] * plane.normal[1] + plane.normal[2] * plane.normal[2]);
+    
+    if (length > 0) {
+        
+        new_face.set_normal(CGPointf(plane.normal[0] / length, plane.normal[1] / length, plane.normal[2] / length));
+    }
+    
+    return convex_hull.add_face(new_face);
+}
+
+// Create the tethraedron in the convex hull DCEL.
+void hull_algorithm::create_tethraedron(DCEL &convex_hull, int v0, int v1, int v2, int v3)
+{
+    // Create edges and set their twins
+    int h0 = create_half_edge(convex_hull, v2, v1);
+    int h1 = create_half_edge(convex_hull, v1, v2);
+    convex_hull.set_half_edge_twin(h0, h1);
+    convex_hull.set_half_edge_twin(h1, h0);
+    
+    int h2 = create_half_edge(convex_hull, v2, v0);
+    int h3 = create_half_edge(convex_hull, v0, v2);
+    convex_hull.set_half_edge_twin(h2, h3);
+    convex_hull.set_half_edge_twin(h3, h2);
+    
+    int h4 = create_half_edge(convex_hull, v2, v3);
+    int h5 = create_half_edge(convex_hull, v3, v2);
+    convex_hull.set_half_edge_twin(h4, h5);
+    convex_hull.set_half_edge_twin(h5, h4);
+    
+    int h6 = create_half_edge(convex_hull, v1, v0);
+    int h7 = create_half_edge(convex_hull, v0, v1);
+    convex_hull.set_half_edge_twin(h6, h7);
+    convex_hull.set_half_edge_twin(h7, h6);
+    
+    int h8 = create_half_edge(convex_hull, v1, v3);
+    int h9 = create_half_edge(convex_hull, v3, v1);
+    convex_hull.set_half_edge_twin(h8, h9);
+    convex_hull.set_half_edge_twin(h9, h8);
+    
+    int h10 = create_half_edge(convex_hull, v0, v3);
+    int h11 = create_half_edge(convex_hull, v3, v0);
+    convex_hull.set_half_edge_twin(h10, h11);
+    convex_hull.set_half_edge_twin(h11, h10);
+    
+    // Set half-edges' nexts
+    convex_hull.set_half_edge_next(h0, h8);
+    convex_hull.set_half_edge_next(h8, h5);
+    convex_hull.set_half_edge_next(h5, h0);
+    
+    convex_hull.set_half_edge_next(h1, h2);
+    convex_hull.set_half_edge_next(h2, h7);
+    convex_hull.set_half_edge_next(h7, h1);
+    
+    convex_hull.set_half_edge_next(h6, h10);
+    convex_hull.set_half_edge_next(h10, h9);
+    convex_hull.set_half_edge_next(h9, h6);
+    
+    convex_hull.set_half_edge_next(h4, h11);
+    convex_hull.set_half_edge_next(h11, h3);
+    convex_hull.set_half_edge_next(h3, h4);
+    
+    // Create faces
+    int f0 = create_face(convex_hull, h0);
+    int f1 = create_face(convex_hull, h1);
+    int f2 = create_face(convex_hull, h6);
+    int f3 = create_face(convex_hull, h4);
+
+    convex_hull.set_face_in_convex_hull(f0, true);
+    convex_hull.set_face_in_convex_hull(f1, true);
+    convex_hull.set_face_in_convex_hull(f2, true);
+    convex_hull.set_face_in_convex_hull(f3, true);
+    
+    // Set half-edges' incident faces
+    convex_hull.set_half_edge_face(h0, f0);
+    convex_hull.set_half_edge_face(h1, f1);
+    convex_hull.set_half_edge_face(h2, f1);
+    convex_hull.set_half_edge_face(h3, f3);
+    convex_hull.set_half_edge_face(h4, f3);
+    convex_hull.set_half_edge_face(h5, f0);
+    convex_hull.set_half_edge_face(h6, f2);
+    convex_hull.set_half_edge_face(h7, f1);
+    convex_hull.set_half_edge_face(h8, f0);
+    convex_hull.set_half_edge_face(h9, f2);
+    convex_hull.set_half_edge_face(h10, f2);
+    convex_hull.set_half_edge_face(h11, f3);
+}
+
+// Create the face which joins the horizon edge "horizon_edge" with the vertex "new_vertex". The two new half-edges are appended
+// to "edges_to_set_twin", so that their twins can be set once the whole cone is built. Return the position of the new face.
+int hull_algorithm::create_cone_face(DCEL &convex_hull, int horizon_edge, int new_vertex, QVector<int> &edges_to_set_twin)
+{
+    half_edge real_horizon_edge = convex_hull.get_half_edge(horizon_edge);
+    
+    // Create two new half-edges
+    int new_half_edge_1 = create_half_edge(convex_hull, real_horizon_edge.to_vertex, new_vertex);
+    int new_half_edge_2 = create_half_edge(convex_hull, new_vertex, real_horizon_edge.from_vertex);
+    
+    edges_to_set_twin.append(new_half_edge_1);
+    edges_to_set_twin.append(new_half_edge_2);
+    
+    // Set half-edges nexts
+    convex_hull.set_half_edge_next(horizon_edge, new_half_edge_1);
+    convex_hull.set_half_edge_next(new_half_edge_1, new_half_edge_2);
+    convex_hull.set_half_edge_next(new_half_edge_2, horizon_edge);
+    
+    // Create the new face
+    int new_face = create_face(convex_hull, horizon_edge);
+    
+    // Set the face visible in the convex hull
+    convex_hull.set_face_in_convex_hull(new_face, true);
+    
+    // Set half-edges' incident face
+    convex_hull.set_half_edge_face(horizon_edge, new_face);
+    convex_hull.set_half_edge_face(new_half_edge_1, new_face);
+    convex_hull.set_half_edge_face(new_half_edge_2, new_face);
+    
+    return new_face;
+}
+
+// Find four points which span a tethraedron, starting from the extreme points along the axes:
+// the two farthest extreme points, the point farthest from their line and the point farthest from their plane.
+// The choice is deterministic and linear, and the tethraedron is never flat: return false if all the points are coplanar.
+bool hull_algorithm::find_extreme_tethraedron(const QVector<vertex> &vertex_list, int &p0, int &p1, int &p2, int &p3)
+{
+    if (vertex_list.size() < STARTING_POINTS) {
+        
+        return false;
+    }
+    
+    // Minimum and maximum point along each axis
+    int extremes[6] = {0, 0, 0, 0, 0, 0};
+    
+    for (int i = 1; i < vertex_list.size(); i++) {
+        
+        CGPointf point = vertex_list[i].coord;
+        
+        if (point.x < vertex_list[extremes[0]].coord.x) extremes[0] = i;
+        if (point.x > vertex_list[extremes[1]].coord.x) extremes[1] = i;
+        if (point.y < vertex_list[extremes[2]].coord.y) extremes[2] = i;
+        if (point.y > vertex_list[extremes[3]].coord.y) extremes[3] = i;
+        if (point.z < vertex_list[extremes[4]].coord.z) extremes[4] = i;
+        if (point.z > vertex_list[extremes[5]].coord.z) extremes[5] = i;
+    }
+    
+    // The two farthest extreme points
+    double max_distance = 0;
+    
+    for (int i = 0; i < 6; i++) {
+        
+        for (int j = i + 1; j < 6; j++) {
+            
+            CGPointf d = vertex_list[extremes[i]].coord - vertex_list[extremes[j]].coord;
+            double distance = (double)d.x * d.x + (double)d.y * d.y + (double)d.z * d.z;
+            
+            if (distance > max_distance) {
+                
+                max_distance = distance;
+                p0 = extremes[i];
+                p1 = extremes[j];
+            }
+        }
+    }
+    
+    // All the points are coincident
+    if (max_distance == 0) {
+        
+        return false;
+    }
+    
+    // The point farthest from the line p0-p1, in double precision
+    CGPointf a = vertex_list[p0].coord;
+    CGPointf b = vertex_list[p1].coord;
+    double line[3] = {(double)b.x - a.x, (double)b.y - a.y, (double)b.z - a.z};
+    max_distance = 0;
+    
+    for (int i = 0; i < vertex_list.size(); i++) {
+        
+        CGPointf point = vertex_list[i].coord;
+        double d[3] = {(double)point.x - a.x, (double)point.y - a.y, (double)point.z - a.z};
+        double n[3] = {line[1] * d[2] - line[2] * d[1], line[2] * d[0] - line[0] * d[2], line[0] * d[1] - line[1] * d[0]};
+        double distance = n[0] * n[0] + n[1] * n[1] + n[2] * n[2];
+        
+        if (distance > max_distance) {
+            
+            max_distance = distance;
+            p2 = i;
+        }
+    }
+    
+    // All the points are collinear
+    if (max_distance == 0) {
+        
+        return false;
+    }
+    
+    // The point farthest from the plane p0-p1-p2, which gives the tethraedron of largest volume on that base
+    CGPointf c = vertex_list[p2].coord;
+    double side[3] = {(double)c.x - a.x, (double)c.y - a.y, (double)c.z - a.z};
+    double normal[3] = {line[1] * side[2] - line[2] * side[1], line[2] * side[0] - line[0] * side[2], line[0] * side[1] - line[1] * side[0]};
+    max_distance = 0;
+    
+    for (int i = 0; i < vertex_list.size(); i++) {
+        
+        CGPointf point = vertex_list[i].coord;
+        double distance = fabs(normal[0] * ((double)point.x - a.x) + normal[1] * ((double)point.y - a.y) + normal[2] * ((double)point.z - a.z));
+        
+        if (distance > max_distance) {
+            
+            max_distance = distance;
+            p3 = i;
+        }
+    }
+    
+    // The distances are rounded, so check the tethraedron with the exact predicate. If it is flat, any point off the
+    // plane will do, and if there is none all the points are coplanar.
+    if (max_distance == 0 || orient3d(a, b, c, vertex_list[p3].coord) == 0) {
+        
+        p3 = -1;
+        
+        for (int i = 0; i < vertex_list.size() && p3 == -1; i++) {
+            
+            if (orient3d(a, b, c, vertex_list[i].coord) != 0) {
+                
+                p3 = i;
+            }
+        }
+        
+        if (p3 == -1) {
+            
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+// Compute the visibility determinant of the face "face_id" and the vertex "point", from the plane of the face. It is positive if the
+// face is visible from the point, its sign is exact, and for a given face its value grows with the distance of the point from the plane.
+double hull_algorithm::visibility_determinant(DCEL &convex_hull, int face_id, const vertex &point)
+{
+    return plane_distance(convex_hull.get_face_plane(face_id), point.coord);
+}
+
+// Check if a face is visible from the vertex "point".
+bool hull_algorithm::is_face_visible(DCEL &convex_hull, int face_id, const vertex &point)
+{
+    // If the determinant is positive, the face is visible
+    if (visibility_determinant(convex_hull, face_id, point) > 0) {
+        
+        return true;
+    }
+    
+    return false;
+}
+
+// Find the faces visible from "point", starting from the visible face "face_id" and walking the adjacent faces. The visible
+// faces of a point outside a convex polyhedron are connected, so the faces next to a face not visible aren't checked.
+void hull_algorithm::find_visible_faces(DCEL &convex_hull, int face_id, const vertex &point, QVector<int> &visible_faces)
+{
+    stamp++;
+    face_stamp.resize(convex_hull.get_faces_n());
+    
+    face_stamp[face_id] = stamp;
+    visible_faces.append(face_id);
+    
+    for (int i = 0; i < visible_faces.size(); i++) {
+        
+        int h = convex_hull.get_face(visible_faces[i]).get_inner_half_edge();
+        
+        // Check the three faces adjacent to the visible face
+        for (int j = 0; j < 3; j++) {
+            
+            half_edge real_h = convex_hull.get_half_edge(h);
+            int adjacent_face = convex_hull.get_half_edge(real_h.get_twin()).get_face();
+            
+            if (face_stamp[adjacent_face] != stamp) {
+                
+                face_stamp[adjacent_face] = stamp;
+                
+                if (is_face_visible(convex_hull, adjacent_face, point)) {
+                    
+                    visible_faces.append(adjacent_face);
+                }
+            }
+            
+            h = real_h.get_next();
+        }
+    }
+}
+
+// Find the horizon of the visible faces, as the cycle of their half-edges whose twin is on a face not visible, in the order in which
+// they follow each other: the "to" vertex of each edge is the "from" vertex of the next one. The visible faces are marked with a
+// new stamp, so testing if a face is visible costs O(1), and each edge of the visible region is walked at most twice.
+// The visible faces have to be a connected region without holes, as they are for a point outside a convex polyhedron.
+void hull_algorithm::find_horizon(DCEL &convex_hull, QVector<int> &visible_faces, QVector<int> &horizon_edges)
+{
+    mark_visible_faces(convex_hull, visible_faces);
+    
+    // Find a first horizon edge
+    int first_edge = -1;
+    
+    for (int i = 0; i < visible_faces.size() && first_edge == -1; i++) {
+        
+        int h = convex_hull.get_face(visible_faces[i]).get_inner_half_edge();
+        
+        for (int j = 0; j < 3 && first_edge == -1; j++) {
+            
+            half_edge real_h = convex_hull.get_half_edge(h);
+            
+            if (!is_face_marked(convex_hull.get_half_edge(real_h.get_twin()).get_face())) {
+                
+                first_edge = h;
+            }
+            
+            h = real_h.get_next();
+        }
+    }
+    
+    // Walk the horizon: from the end of an horizon edge, turn around its "to" vertex through the visible faces until an edge
+    // leads out of the visible region
+    int horizon_edge = first_edge;
+    
+    do {
+        
+        horizon_edges.append(horizon_edge);
+        
+        int h = convex_hull.get_half_edge(horizon_edge).get_next();
+        half_edge real_h = convex_hull.get_half_edge(h);
+        
+        while (is_face_marked(convex_hull.get_half_edge(real_h.get_twin()).get_face())) {
+            
+            h = convex_hull.get_half_edge(real_h.get_twin()).get_next();
+            real_h = convex_hull.get_half_edge(h);
+        }
+        
+        horizon_edge = h;
+    } while (horizon_edge != first_edge);
+}
+
+// Hide from the convex hull the visible faces, with their half-edges and vertexes which aren't on the horizon.
+void hull_algorithm::hide_visible_region(DCEL &convex_hull, QVector<int> &visible_faces, QVector<int> &horizon_edges)
+{
+    mark_visible_faces(convex_hull, visible_faces);
+    
+    // Mark the vertexes on the horizon
+    vertex_stamp.resize(convex_hull.get_vertex_n());
+    
+    for (int i = 0; i < horizon_edges.size(); i++) {
+        
+        vertex_stamp[convex_hull.get_half_edge(horizon_edges[i]).get_from_vertex()] = stamp;
+    }
+    
+    for (int i = 0; i < visible_faces.size(); i++) {
+        
+        int h = convex_hull.get_face(visible_faces[i]).get_inner_half_edge();
+        
+        for (int j = 0; j < 3; j++) {
+            
+            half_edge real_h = convex_hull.get_half_edge(h);
+            
+            // The half-edges between two visible faces are inside the visible region
+            if (is_face_marked(convex_hull.get_half_edge(real_h.get_twin()).get_face())) {
+                
+                convex_hull.set_half_edge_in_convex_hull(h, false);
+            }
+            
+            if (vertex_stamp[real_h.get_from_vertex()] != stamp) {
+                
+                convex_hull.set_vertex_in_convex_hull(real_h.get_from_vertex(), false);
+            }
+            
+            h = real_h.get_next();
+        }
+        
+        // Hide the face from convex hull
+        convex_hull.set_face_in_convex_hull(visible_faces[i], false);
+    }
+}
+
+// Mark the visible faces with a new stamp.
+void hull_algorithm::mark_visible_faces(DCEL &convex_hull, QVector<int> &visible_faces)
+{
+    stamp++;
+    face_stamp.resize(convex_hull.get_faces_n());
+    
+    for (int i = 0; i < visible_faces.size(); i++) {
+        
+        face_stamp[visible_faces[i]] = stamp;
+    }
+}
+
+bool hull_algorithm::is_face_marked(int face_id)
+{
+    return face_stamp[face_id] == stamp;
+}
+
+// Set the twins of the half-edges in the list, which are matched by their vertexes through the edge index. Then, empty the list.
+void hull_algorithm::set_correct_twin(DCEL &convex_hull, QVector<int> &half_edge_list)
+{
+    open_edges.clear();
+    
+    for (int i = 0; i < half_edge_list.size(); i++) {
+        
+        half_edge real_half_edge = convex_hull.get_half_edge(half_edge_list[i]);
+        
+        // If the half-edge with from and to vertexes inverted has been seen, then they are twins
+        int twin = open_edges.take(real_half_edge.get_to_vertex(), real_half_edge.get_from_vertex());
+        
+        if (twin != -1) {
+            
+            convex_hull.set_half_edge_twin(half_edge_list[i], twin);
+            convex_hull.set_half_edge_twin(twin, half_edge_list[i]);
+        } else {
+            
+            open_edges.insert(real_half_edge.get_from_vertex(), real_half_edge.get_to_vertex(), half_edge_list[i]);
+        }
+    }
+    
+    half_edge_list.clear();
+}
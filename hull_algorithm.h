@@ -0,0 +1,77 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HULL_ALGORITHM_H
+#define HULL_ALGORITHM_H
+
+#include <QVector>
+#include "dcel/DCEL.hh"
+#include "edge_index.h"
+
+#define STARTING_POINTS 4
+
+// Base class of the algorithms which compute the 3D convex hull of a set of points into a DCEL.
+// It keeps the operations on the DCEL shared by all of them.
+class hull_algorithm
+{
+    public:
+        
+        hull_algorithm();
+        virtual ~hull_algorithm();
+        
+        // Compute the convex hull of the vertexes in "vertex_list" into "convex_hull".
+        // Return false if the vertexes don't span a volume.
+        virtual bool calculate(QVector<vertex> &vertex_list, DCEL &convex_hull) = 0;
+        
+    protected:
+        
+        void swap_vertex(QVector<vertex> &vertex_list, int vertex1, int vertex2);
+        
+        int create_half_edge(DCEL &convex_hull, int from_vertex, int to_vertex);
+        int create_face(DCEL &convex_hull, int inner_edge);
+        void create_tethraedron(DCEL &convex_hull, int v0, int v1, int v2, int v3);
+        int create_cone_face(DCEL &convex_hull, int horizon_edge, int new_vertex, QVector<int> &edges_to_set_twin);
+        
+        bool find_extreme_tethraedron(const QVector<vertex> &vertex_list, int &p0, int &p1, int &p2, int &p3);
+        
+        double visibility_determinant(DCEL &convex_hull, int face_id, const vertex &point);
+        bool is_face_visible(DCEL &convex_hull, int face_id, const vertex &point);
+        
+        void find_visible_faces(DCEL &convex_hull, int face_id, const vertex &point, QVector<int> &visible_faces);
+        void find_horizon(DCEL &convex_hull, QVector<int> &visible_faces, QVector<int> &horizon_edges);
+        void hide_visible_region(DCEL &convex_hull, QVector<int> &visible_faces, QVector<int> &horizon_edges);
+        
+        void set_correct_twin(DCEL &convex_hull, QVector<int> &half_edge_list);
+        
+    private:
+        
+        void mark_visible_faces(DCEL &convex_hull, QVector<int> &visible_faces);
+        bool is_face_marked(int face_id);
+        
+        // Stamps of the faces and vertexes marked by the last visit, so the marks never have to be cleared
+        QVector<int> face_stamp;
+        QVector<int> vertex_stamp;
+        int stamp;
+        
+        // Half-edges of a cone still waiting for their twin
+        edge_index open_edges;
+};
+
+#endif // HULL_ALGORITHM_H
@@ -0,0 +1,534 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "incremental_hull.h"
+#include <algorithm>
+#include <QThread>
+#include <QPair>
+#include <QtConcurrentMap>
+#include "predicates.h"
+
+using namespace std;
+
+incremental_hull::incremental_hull()
+{
+    single_conflict = false;
+    spatial_order = false;
+    hidden_faces_n = 0;
+}
+
+void incremental_hull::set_single_conflict(bool single)
+{
+    single_conflict = single;
+}
+
+void incremental_hull::set_spatial_order(bool spatial)
+{
+    spatial_order = spatial;
+}
+
+void incremental_hull::set_seed(unsigned int seed)
+{
+    random_engine.seed(seed);
+}
+
+// Randomized incremental algorithm: the points are inserted in random order, and a conflict graph
+// keeps, for each point not yet inserted, the faces of the current convex hull visible from it.
+bool incremental_hull::calculate(QVector<vertex> &vertex_list, DCEL &convex_hull)
+{
+    // Shuffle the vertexes in the list
+    shuffle(vertex_list.begin(), vertex_list.end(), random_engine);
+    
+    // Start from the tethraedron spanned by the extreme points, whose vertexes are moved to the head of the list
+    int seed[STARTING_POINTS];
+    
+    if (!find_extreme_tethraedron(vertex_list, seed[0], seed[1], seed[2], seed[3])) {
+        
+        return false;
+    }
+    
+    for (int i = 0; i < STARTING_POINTS; i++) {
+        
+        swap_vertex(vertex_list, i, seed[i]);
+        
+        // The point which was at position i is now where the seed point was
+        for (int j = i + 1; j < STARTING_POINTS; j++) {
+            
+            if (seed[j] == i) {
+                
+                seed[j] = seed[i];
+            }
+        }
+    }
+    
+    int v0 = convex_hull.add_vertex(vertex_list[0]);
+    int v1 = convex_hull.add_vertex(vertex_list[1]);
+    int v2 = convex_hull.add_vertex(vertex_list[2]);
+    int v3 = convex_hull.add_vertex(vertex_list[3]);
+    
+    // If the determinant is positive, the fourh point see the face in counterclockwise sense, and the face from outside would be in clockwise sense.
+    // So, if the determinant is positive, the tethraedron will be constructed with the points in the reverse order.
+    if (orient3d(vertex_list[0].coord, vertex_list[1].coord, vertex_list[2].coord, vertex_list[3].coord) > 0) {
+        
+        create_tethraedron(convex_hull, v0, v2, v1, v3);
+    } else {
+        
+        create_tethraedron(convex_hull, v0, v1, v2, v3);
+    }
+    
+    if (spatial_order) {
+        
+        sort_in_rounds(vertex_list, STARTING_POINTS);
+    }
+    
+    points.assign(vertex_list);
+    
+    // Check if each face of the tethraedron is visible from each vertex in the list. The points are split in one chunk per thread,
+    // and each thread collects its arches in its own list.
+    int chunks_n = QThread::idealThreadCount();
+    int points_n = vertex_list.size() - STARTING_POINTS;
+    QVector<conflict_chunk> chunks(chunks_n);
+    
+    for (int i = 0; i < chunks_n; i++) {
+        
+        chunks[i].points = &points;
+        chunks[i].begin = STARTING_POINTS + (qint64)points_n * i / chunks_n;
+        chunks[i].end = STARTING_POINTS + (qint64)points_n * (i + 1) / chunks_n;
+        chunks[i].first_only = single_conflict;
+        
+        for (int j = 0; j < STARTING_POINTS; j++) {
+            
+            chunks[i].faces[j] = convex_hull.get_face_plane(j);
+        }
+    }
+    
+    QtConcurrent::blockingMap(chunks, find_conflicts);
+    
+    // With a single conflict, each point keeps the first face of the tethraedron it can see
+    if (single_conflict) {
+        
+        QVector<int> conflict_face(vertex_list.size(), -1);
+        
+        for (int i = 0; i < chunks_n; i++) {
+            
+            QVector<int> &arches = chunks[i].arches;
+            
+            for (int j = 0; j < arches.size(); j += 2) {
+                
+                conflict_face[arches[j + 1]] = arches[j];
+            }
+        }
+        
+        chunks.clear();
+        insert_with_single_conflict(vertex_list, convex_hull, conflict_face);
+        
+        return true;
+    }
+    
+    conflict_graph conf_graph;
+    
+    candidate_mark.fill(0, vertex_list.size());
+    candidate_visit = 0;
+    
+    // Add face nodes in the conflict graph for the tethraedron faces
+    for (int i = 0; i < convex_hull.get_faces_n(); i++) {
+        
+        conf_graph.add_face_node(i);
+    }
+    
+    // Add a node in the conflict graph for each vertex
+    for (int i = STARTING_POINTS; i < vertex_list.size(); i++) {
+        
+        conf_graph.add_vertex_node(i);
+    }
+    
+    // Merge the arches found by the threads, in the order of the points
+    for (int i = 0; i < chunks_n; i++) {
+        
+        QVector<int> &arches = chunks[i].arches;
+        
+        for (int j = 0; j < arches.size(); j += 2) {
+            
+            conf_graph.create_arch(arches[j], arches[j + 1]);
+        }
+    }
+    
+    // Insert the other points, replacing the faces visible from each of them with new faces
+    insert_sequentially(vertex_list, convex_hull, conf_graph, STARTING_POINTS);
+    
+    return true;
+}
+
+// Spread the lowest MORTON_BITS bits of "x" three bits apart, to interleave them with the ones of the other coordinates.
+static quint64 spread_bits(quint64 x)
+{
+    quint64 spread = 0;
+    
+    for (int i = 0; i < MORTON_BITS; i++) {
+        
+        spread |= ((x >> i) & 1) << (3 * i);
+    }
+    
+    return spread;
+}
+
+// Biased randomized insertion order: each point goes into the last round with probability 1/2, else into the previous one
+// with probability 1/2, and so on, so the rounds double in size. The rounds are inserted from the smallest one, and the
+// points of each round are sorted along a Morton curve of the bounding box.
+void incremental_hull::sort_in_rounds(QVector<vertex> &vertex_list, int first_point)
+{
+    int points_n = vertex_list.size() - first_point;
+    
+    if (points_n < 2) {
+        
+        return;
+    }
+    
+    CGPointf min = vertex_list.at(first_point).coord;
+    CGPointf max = min;
+    
+    for (int i = first_point + 1; i < vertex_list.size(); i++) {
+        
+        const CGPointf &p = vertex_list.at(i).coord;
+        
+        min.x = std::min(min.x, p.x); max.x = std::max(max.x, p.x);
+        min.y = std::min(min.y, p.y); max.y = std::max(max.y, p.y);
+        min.z = std::min(min.z, p.z); max.z = std::max(max.z, p.z);
+    }
+    
+    // Scale of each axis onto the cells of the Morton curve
+    double cells = (1 << MORTON_BITS) - 1;
+    double scale_x = max.x > min.x ? cells / ((double)max.x - min.x) : 0;
+    double scale_y = max.y > min.y ? cells / ((double)max.y - min.y) : 0;
+    double scale_z = max.z > min.z ? cells / ((double)max.z - min.z) : 0;
+    
+    // The first round gets about 1 point
+    int rounds_n = 1;
+    
+    while ((1 << rounds_n) < points_n && rounds_n < 30) {
+        
+        rounds_n++;
+    }
+    
+    // Sort key of each point: its round, then its Morton code
+    QVector< QPair<quint64, int> > keys(points_n);
+    
+    for (int i = 0; i < points_n; i++) {
+        
+        const CGPointf &p = vertex_list.at(first_point + i).coord;
+        
+        int round = rounds_n - 1;
+        
+        while (round > 0 && (random_engine() & 1)) {
+            
+            round--;
+        }
+        
+        quint64 morton = spread_bits((quint64)((p.x - min.x) * scale_x)) |
+                         spread_bits((quint64)((p.y - min.y) * scale_y)) << 1 |
+                         spread_bits((quint64)((p.z - min.z) * scale_z)) << 2;
+        
+        keys[i] = qMakePair(((quint64)round << (3 * MORTON_BITS)) | morton, first_point + i);
+    }
+    
+    std::sort(keys.begin(), keys.end());
+    
+    QVector<vertex> sorted(points_n);
+    
+    for (int i = 0; i < points_n; i++) {
+        
+        sorted[i] = vertex_list.at(keys[i].second);
+    }
+    
+    for (int i = 0; i < points_n; i++) {
+        
+        vertex_list[first_point + i] = sorted[i];
+    }
+}
+
+// Test the points of a chunk against the faces of the tethraedron. It only reads the points, so the chunks can run in parallel.
+void incremental_hull::find_conflicts(conflict_chunk &chunk)
+{
+    QVector<QVector<int> > visible(STARTING_POINTS);
+    
+    for (int i = 0; i < STARTING_POINTS; i++) {
+        
+        visible[i].resize(chunk.end - chunk.begin);
+        visible[i].resize(chunk.points->visible_points(chunk.faces[i], chunk.begin, chunk.end, visible[i].data()));
+    }
+    
+    // If the face is visible from the vertex, an arch will be created in the conflict graph between them.
+    // The arches are listed in the order of the points, as the conflict graph would receive them testing one point at a time.
+    QVector<int> next(STARTING_POINTS, 0);
+    
+    for (int i = chunk.begin; i < chunk.end; i++) {
+        
+        bool found = false;
+        
+        for (int j = 0; j < STARTING_POINTS; j++) {
+            
+            if (next[j] < visible[j].size() && visible[j][next[j]] == i) {
+                
+                if (!found || !chunk.first_only) {
+                    
+                    chunk.arches.append(j);
+                    chunk.arches.append(i);
+                }
+                
+                found = true;
+                next[j]++;
+            }
+        }
+    }
+}
+
+// Insert the points one at a time, in the order of the list.
+void incremental_hull::insert_sequentially(QVector<vertex> &vertex_list, DCEL &convex_hull, conflict_graph &conf_graph, int first_point)
+{
+    for (int i = first_point; i < vertex_list.size(); i++) {
+        
+        insertion_plan plan;
+        plan.vertex_list = &vertex_list;
+        plan.points = &points;
+        plan.point = i;
+        
+        // Obtain the list of visible faces from the vertex i
+        plan.visible_faces = conf_graph.get_visible_faces(i);
+        
+        // If there are visible faces, then the vertex is outside the convex hull
+        if (plan.visible_faces.size() > 0) {
+            
+            plan_insertion(convex_hull, conf_graph, plan);
+            find_new_conflicts(plan);
+            insert_point(convex_hull, conf_graph, plan);
+        }
+    }
+}
+
+// Insert the points one at a time, keeping for each of them only one face it can see, in "conflict_face" (-1 if the point is inside
+// the convex hull). The points of each face are kept in a list, linked through "next_point". When a point is inserted, the faces it
+// sees are found walking the convex hull from its face. The points of the removed faces are moved to the first new face they see;
+// if they see none, the faces they see can only be the old faces next to the horizon, as the faces visible from a point are connected.
+void incremental_hull::insert_with_single_conflict(QVector<vertex> &vertex_list, DCEL &convex_hull, QVector<int> &conflict_face)
+{
+    QVector<int> first_point(convex_hull.get_faces_n(), -1);
+    QVector<int> next_point(vertex_list.size(), -1);
+    
+    // Build the lists backwards, so they are in the order of the points
+    for (int i = vertex_list.size() - 1; i >= STARTING_POINTS; i--) {
+        
+        if (conflict_face[i] != -1) {
+            
+            next_point[i] = first_point[conflict_face[i]];
+            first_point[conflict_face[i]] = i;
+        }
+    }
+    
+    for (int i = STARTING_POINTS; i < vertex_list.size(); i++) {
+        
+        // The vertex is inside the convex hull
+        if (conflict_face[i] == -1) {
+            
+            continue;
+        }
+        
+        QVector<int> visible_faces;
+        QVector<int> horizon_edges;
+        QVector<int> edges_to_set_twin;
+        QVector<int> new_faces;
+        
+        find_visible_faces(convex_hull, conflict_face[i], vertex_list[i], visible_faces);
+        
+        // Add the vertex to convex hull
+        int new_vertex = convex_hull.add_vertex(vertex_list[i]);
+        
+        find_horizon(convex_hull, visible_faces, horizon_edges);
+        hide_visible_region(convex_hull, visible_faces, horizon_edges);
+        
+        for (int j = 0; j < horizon_edges.size(); j++) {
+            
+            new_faces.append(create_cone_face(convex_hull, horizon_edges[j], new_vertex, edges_to_set_twin));
+        }
+        
+        set_correct_twin(convex_hull, edges_to_set_twin);
+        
+        first_point.resize(convex_hull.get_faces_n());
+        
+        for (int j = 0; j < new_faces.size(); j++) {
+            
+            first_point[new_faces[j]] = -1;
+        }
+        
+        conflict_face[i] = -1;
+        
+        // Move the points of the removed faces
+        for (int j = 0; j < visible_faces.size(); j++) {
+            
+            int point = first_point[visible_faces[j]];
+            first_point[visible_faces[j]] = -1;
+            
+            while (point != -1) {
+                
+                int next = next_point[point];
+                int face_id = -1;
+                
+                // The inserted vertex is in the list of its face too
+                if (point == i) {
+                    
+                    point = next;
+                    continue;
+                }
+                
+                for (int k = 0; k < new_faces.size() && face_id == -1; k++) {
+                    
+                    if (is_face_visible(convex_hull, new_faces[k], vertex_list[point])) {
+                        
+                        face_id = new_faces[k];
+                    }
+                }
+                
+                // The horizon edges are on the new faces now, and their twins on the old faces next to the horizon
+                for (int k = 0; k < horizon_edges.size() && face_id == -1; k++) {
+                    
+                    int old_face = convex_hull.get_half_edge(convex_hull.get_half_edge(horizon_edges[k]).get_twin()).get_face();
+                    
+                    if (is_face_visible(convex_hull, old_face, vertex_list[point])) {
+                        
+                        face_id = old_face;
+                    }
+                }
+                
+                conflict_face[point] = face_id;
+                
+                if (face_id != -1) {
+                    
+                    next_point[point] = first_point[face_id];
+                    first_point[face_id] = point;
+                }
+                
+                point = next;
+            }
+        }
+    }
+}
+
+// Find the horizon edges of the faces visible from the point of the plan and, for each of them, the vertexes of the new face
+// and the points to test against it. It only reads the convex hull and the conflict graph.
+void incremental_hull::plan_insertion(DCEL &convex_hull, conflict_graph &conf_graph, insertion_plan &plan)
+{
+    const CGPointf &new_point = plan.vertex_list->at(plan.point).coord;
+    
+    find_horizon(convex_hull, plan.visible_faces, plan.horizon_edges);
+    
+    for (int i = 0; i < plan.horizon_edges.size(); i++) {
+        
+        half_edge real_h = convex_hull.get_half_edge(plan.horizon_edges[i]);
+        
+        int old_face = real_h.get_face();
+        int old_face_twin = convex_hull.get_half_edge(real_h.get_twin()).get_face();
+        
+        face_plane new_face;
+        set_face_plane(new_face, convex_hull.get_vertex(real_h.get_from_vertex()).get_coord(),
+                       convex_hull.get_vertex(real_h.get_to_vertex()).get_coord(), new_point);
+        plan.new_faces.append(new_face);
+        
+        // Find the vertexes which could see the face incident to the horizon edge and the one incident on its twin.
+        // The vertexes of the first face are marked, so the ones of the second face are added only once.
+        QVector<int> visible_vertexes;
+        candidate_visit++;
+        
+        for (conflict_iterator vertex = conf_graph.visible_vertexes(old_face); vertex.has_next(); ) {
+            
+            int candidate = vertex.next();
+            
+            candidate_mark[candidate] = candidate_visit;
+            visible_vertexes.append(candidate);
+        }
+        
+        for (conflict_iterator vertex = conf_graph.visible_vertexes(old_face_twin); vertex.has_next(); ) {
+            
+            int candidate = vertex.next();
+            
+            if (candidate_mark[candidate] != candidate_visit) {
+                
+                visible_vertexes.append(candidate);
+            }
+        }
+        
+        plan.candidates.append(visible_vertexes);
+    }
+    
+    plan.conflicts.resize(plan.candidates.size());
+}
+
+// Check the visibility of the new faces of the plan with the points found for them. It only reads the plan and the points.
+void incremental_hull::find_new_conflicts(insertion_plan &plan)
+{
+    for (int i = 0; i < plan.candidates.size(); i++) {
+        
+        const QVector<int> &candidates = plan.candidates[i];
+        QVector<int> &conflicts = plan.conflicts[i];
+        
+        conflicts.resize(candidates.size());
+        conflicts.resize(plan.points->visible_points(plan.new_faces[i], candidates.constData(), candidates.size(), conflicts.data()));
+    }
+}
+
+// Add the point of the plan to the convex hull, replacing the visible faces with the new faces and the arches found for them.
+void incremental_hull::insert_point(DCEL &convex_hull, conflict_graph &conf_graph, insertion_plan &plan)
+{
+    QVector<int> &horizon_edges = plan.horizon_edges;
+    QVector<int> edges_to_set_twin;
+    
+    // Add the vertex to convex hull
+    int new_vertex = convex_hull.add_vertex(plan.vertex_list->at(plan.point));
+    
+    // Hide the visible faces, with the half-edges and vertexes inside the horizon
+    hide_visible_region(convex_hull, plan.visible_faces, horizon_edges);
+    hidden_faces_n += plan.visible_faces.size();
+    
+    // For each horizon edge, create a new face with the arches of the points which see it
+    for (int i = 0; i < horizon_edges.size(); i++) {
+        
+        int new_face = create_cone_face(convex_hull, horizon_edges[i], new_vertex, edges_to_set_twin);
+        
+        // Create a new node in the conflict graph for the new face
+        conf_graph.add_face_node(new_face);
+        
+        const QVector<int> &conflicts = plan.conflicts[i];
+        
+        for (int j = 0; j < conflicts.size(); j++) {
+            
+            conf_graph.create_arch(new_face, conflicts[j]);
+        }
+    }
+    
+    // Check the new edges to set the correct twins
+    set_correct_twin(convex_hull, edges_to_set_twin);
+    
+    // Remove the old faces from the conflict graph
+    for (int i = 0; i < plan.visible_faces.size(); i++) {
+        
+        conf_graph.remove_face_node(plan.visible_faces[i]);
+    }
+    
+    // Remove the new vertex from the conflict graph
+    conf_graph.remove_vertex_node(plan.point);
+}
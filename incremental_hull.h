@@ -0,0 +1,122 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCREMENTAL_HULL_H
+#define INCREMENTAL_HULL_H
+
+#include <random>
+#include "hull_algorithm.h"
+#include "conflict_graph.h"
+#include "point_block.h"
+
+// Bits of each coordinate in the Morton code of the spatially coherent order
+#define MORTON_BITS 16
+
+// Range of points tested against the faces of the tethraedron by one thread, with the arches found for them
+struct conflict_chunk
+{
+    const point_block *points;
+    face_plane faces[STARTING_POINTS];
+    
+    int begin;
+    int end;
+    
+    // Keep only the first face visible from each point
+    bool first_only;
+    
+    // Pairs of face and vertex to join with an arch
+    QVector<int> arches;
+};
+
+// Insertion of a point: the faces visible from it, their horizon and, for each horizon edge, the new face built on it with the points which could see it
+struct insertion_plan
+{
+    const QVector<vertex> *vertex_list;
+    const point_block *points;
+    int point;
+    
+    QVector<int> visible_faces;
+    
+    // Horizon of the visible faces, as an ordered cycle of half-edges
+    QVector<int> horizon_edges;
+    
+    // Plane of the new face built on each horizon edge
+    QVector<face_plane> new_faces;
+    
+    // Points to test against the new face of each horizon edge, and the ones which see it
+    QVector< QVector<int> > candidates;
+    QVector< QVector<int> > conflicts;
+};
+
+class incremental_hull : public hull_algorithm
+{
+    public:
+        
+        incremental_hull();
+        
+        bool calculate(QVector<vertex> &vertex_list, DCEL &convex_hull);
+        
+        // Keep a single face visible from each point instead of the whole conflict graph. The memory is O(n), and the faces
+        // visible from a point are found walking the convex hull when it is inserted. The points are inserted one at a time.
+        void set_single_conflict(bool single);
+        
+        // Insert the points in a biased randomized order (BRIO): random rounds of doubling size, each one sorted along a
+        // Morton curve, so consecutive points touch nearby faces while keeping the expected cost of the random order.
+        void set_spatial_order(bool spatial);
+        
+        // Seed the random order of the insertion, so the same seed gives the same convex hull
+        void set_seed(unsigned int seed);
+        
+    protected:
+        
+        bool single_conflict;
+        bool spatial_order;
+        
+        // Random order of the points, of this object only, so hulls computed in parallel don't share the state of rand()
+        std::mt19937 random_engine;
+        
+        // Coordinates of the points, for the visibility tests
+        point_block points;
+        
+        // Last visit of each point while collecting the candidates of a new face
+        QVector<int> candidate_mark;
+        int candidate_visit;
+        
+        // Faces hidden by the insertions, which stay in the DCEL until it is compacted
+        int hidden_faces_n;
+        
+        // Insert the points of "vertex_list" from "first_point" on, whose conflicts are already in the conflict graph
+        void insert_sequentially(QVector<vertex> &vertex_list, DCEL &convex_hull, conflict_graph &conf_graph, int first_point);
+        
+        // Reorder the points of "vertex_list" from "first_point" on in random rounds sorted along a Morton curve
+        void sort_in_rounds(QVector<vertex> &vertex_list, int first_point);
+        
+    private:
+        
+        static void find_conflicts(conflict_chunk &chunk);
+        
+        void insert_with_single_conflict(QVector<vertex> &vertex_list, DCEL &convex_hull, QVector<int> &conflict_face);
+        
+        void plan_insertion(DCEL &convex_hull, conflict_graph &conf_graph, insertion_plan &plan);
+        static void find_new_conflicts(insertion_plan &plan);
+        void insert_point(DCEL &convex_hull, conflict_graph &conf_graph, insertion_plan &plan);
+};
+
+#endif // INCREMENTAL_HULL_H
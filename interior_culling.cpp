@@ -0,0 +1,176 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "interior_culling.h"
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include "quickhull.h"
+
+// Relative error bound of the scan in float, with the faces of the polytope rounded to float
+#define CULLING_ERROR_BOUND (16 * FLT_EPSILON)
+
+// Directions of the extreme points: the axis directions, then the diagonals
+static const float directions[CULLING_DIRECTIONS][3] = {
+    { 1,  0,  0}, {-1,  0,  0}, { 0,  1,  0}, { 0, -1,  0}, { 0,  0,  1}, { 0,  0, -1},
+    { 1,  1,  1}, { 1,  1, -1}, { 1, -1,  1}, { 1, -1, -1},
+    {-1,  1,  1}, {-1,  1, -1}, {-1, -1,  1}, {-1, -1, -1}
+};
+
+int interior_culling::cull(QVector<vertex> &vertex_list)
+{
+    int points_n = vertex_list.size();
+    
+    // With few points, there is nothing to gain
+    if (points_n <= CULLING_DIRECTIONS) {
+        
+        return 0;
+    }
+    
+    x.resize(points_n);
+    y.resize(points_n);
+    z.resize(points_n);
+    inside.fill(1, points_n);
+    
+    // Split the coordinates, and find the largest one to bound the rounding errors
+    float max_coordinate = 0;
+    
+    for (int i = 0; i < points_n; i++) {
+        
+        const CGPointf &point = vertex_list.at(i).coord;
+        
+        x[i] = point.x;
+        y[i] = point.y;
+        z[i] = point.z;
+        
+        max_coordinate = std::max(max_coordinate, std::max(std::fabs(point.x), std::max(std::fabs(point.y), std::fabs(point.z))));
+    }
+    
+    QVector<int> extreme_points;
+    find_extreme_points(extreme_points);
+    
+    QVector<vertex> extreme_vertexes;
+    
+    for (int i = 0; i < extreme_points.size(); i++) {
+        
+        extreme_vertexes.append(vertex_list.at(extreme_points[i]));
+    }
+    
+    // If the extreme points don't span a volume, no point can be discarded
+    DCEL polytope;
+    quickhull hull;
+    
+    if (!hull.calculate(extreme_vertexes, polytope)) {
+        
+        return 0;
+    }
+    
+    // A point is inside if it is on the inner side of every face of the polytope, farther than the rounding errors
+    for (int i = 0; i < polytope.get_faces_n(); i++) {
+        
+        if (!polytope.is_face_in_convex_hull(i)) {
+            
+            continue;
+        }
+        
+        half_edge h0 = polytope.get_half_edge(polytope.get_face(i).get_inner_half_edge());
+        half_edge h1 = polytope.get_half_edge(h0.get_next());
+        
+        CGPointf a = polytope.get_vertex(h0.get_from_vertex()).get_coord();
+        CGPointf b = polytope.get_vertex(h1.get_from_vertex()).get_coord();
+        CGPointf c = polytope.get_vertex(h1.get_to_vertex()).get_coord();
+        
+        // The faces are in clockwise sense from outside, so (c - a) x (b - a) points outside
+        double u[3] = {(double)c.x - a.x, (double)c.y - a.y, (double)c.z - a.z};
+        double v[3] = {(double)b.x - a.x, (double)b.y - a.y, (double)b.z - a.z};
+        
+        double normal_x = u[1] * v[2] - u[2] * v[1];
+        double normal_y = u[2] * v[0] - u[0] * v[2];
+        double normal_z = u[0] * v[1] - u[1] * v[0];
+        double offset = normal_x * a.x + normal_y * a.y + normal_z * a.z;
+        
+        double margin = CULLING_ERROR_BOUND * (std::fabs(normal_x) + std::fabs(normal_y) + std::fabs(normal_z)) * max_coordinate;
+        
+        mark_inside(normal_x, normal_y, normal_z, offset - margin);
+    }
+    
+    // Keep the points which aren't inside
+    int kept = 0;
+    
+    for (int i = 0; i < points_n; i++) {
+        
+        if (!inside[i]) {
+            
+            vertex_list[kept++] = vertex_list.at(i);
+        }
+    }
+    
+    vertex_list.resize(kept);
+    
+    return points_n - kept;
+}
+
+// Find the points with the largest projection on each direction, without repetitions.
+void interior_culling::find_extreme_points(QVector<int> &extreme_points)
+{
+    const float *px = x.constData();
+    const float *py = y.constData();
+    const float *pz = z.constData();
+    
+    for (int i = 0; i < CULLING_DIRECTIONS; i++) {
+        
+        float dx = directions[i][0], dy = directions[i][1], dz = directions[i][2];
+        
+        int extreme = 0;
+        float max_projection = dx * px[0] + dy * py[0] + dz * pz[0];
+        
+        for (int j = 1; j < x.size(); j++) {
+            
+            float projection = dx * px[j] + dy * py[j] + dz * pz[j];
+            
+            if (projection > max_projection) {
+                
+                max_projection = projection;
+                extreme = j;
+            }
+        }
+        
+        if (!extreme_points.contains(extreme)) {
+            
+            extreme_points.append(extreme);
+        }
+    }
+}
+
+// Clear the mark of the points on the outer side of the plane "normal * p = offset". The loop has no branches,
+// so it is vectorized over the coordinate arrays.
+void interior_culling::mark_inside(float normal_x, float normal_y, float normal_z, float offset)
+{
+    const float *px = x.constData();
+    const float *py = y.constData();
+    const float *pz = z.constData();
+    unsigned char *marks = inside.data();
+    int points_n = inside.size();
+    
+    for (int i = 0; i < points_n; i++) {
+        
+        marks[i] &= (normal_x * px[i] + normal_y * py[i] + normal_z * pz[i] < offset);
+    }
+}
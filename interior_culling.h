@@ -0,0 +1,55 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INTERIOR_CULLING_H
+#define INTERIOR_CULLING_H
+
+#include <QVector>
+#include "dcel/DCEL.hh"
+
+// Number of directions along which the extreme points are searched: the 6 axis directions and the 8 diagonals
+#define CULLING_DIRECTIONS 14
+
+// Akl-Toussaint heuristic: the extreme points along a few fixed directions span a polytope inside the convex hull,
+// so every point strictly inside it can be discarded before computing the convex hull. The points are scanned in
+// separate coordinate arrays, with a branchless loop for each face of the polytope which the compiler can vectorize.
+class interior_culling
+{
+    public:
+        
+        // Remove from "vertex_list" the points strictly inside the polytope of the extreme points, and return their number.
+        // The points near the faces of the polytope are kept, so rounding errors can't discard a point of the convex hull.
+        int cull(QVector<vertex> &vertex_list);
+        
+    private:
+        
+        void find_extreme_points(QVector<int> &extreme_points);
+        void mark_inside(float normal_x, float normal_y, float normal_z, float offset);
+        
+        // Coordinates of the points
+        QVector<float> x;
+        QVector<float> y;
+        QVector<float> z;
+        
+        // 1 for the points inside all the faces scanned so far
+        QVector<unsigned char> inside;
+};
+
+#endif // INTERIOR_CULLING_H
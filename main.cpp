@@ -23,12 +23,228 @@
 #include <QDialog>
 #include <QMenu>
 #include <QMenuBar>
+#include <QActionGroup>
+#include <QFileInfo>
+#include <QDir>
 #include "window_gl.h"
 #include "engine.h"
 #include "dcel/DCEL.hh"
 
+// Exit codes of the command line mode
+enum Exit_code { EXIT_OK = 0, EXIT_USAGE = 1, EXIT_LOAD_ERROR = 2, EXIT_HULL_ERROR = 3, EXIT_SAVE_ERROR = 4 };
+
+void print_usage(const char *program)
+{
+	std::cout << "Usage: " << program << " [-a incremental|quickhull|divide|chan] [-c] [-d tolerance] [-s] [-b] [-m points] [-e epsilon] [-u] [-o output] input.off [input2.off ...]" << std::endl;
+	std::cout << "  -a selects the convex hull algorithm (incremental by default)." << std::endl;
+	std::cout << "  -c discards the interior points before computing the convex hull." << std::endl;
+	std::cout << "  -d removes the points in the same cell of a grid of the given side (0 for the exact duplicates)." << std::endl;
+	std::cout << "  -s keeps a single visible face per point in the incremental algorithm." << std::endl;
+	std::cout << "  -b inserts the points of the incremental algorithm in random rounds sorted along a Morton curve." << std::endl;
+	std::cout << "  -m reads the inputs in chunks of the given number of points, keeping only the vertexes of their convex hulls." << std::endl;
+	std::cout << "  -e computes an approximate convex hull, within epsilon times the diagonal of the bounding box." << std::endl;
+	std::cout << "  -u computes the convex hulls of all the inputs in parallel, and writes only the convex hull of their union." << std::endl;
+	std::cout << "  With a single input or with -u, output is the .off file to write." << std::endl;
+	std::cout << "  With more inputs, output is a directory where <input>_hull.off files are written." << std::endl;
+	std::cout << "  Without -o, each hull is written next to its input as <input>_hull.off, and the union next to the first input as union_hull.off." << std::endl;
+}
+
+// Compute the convex hull of every input file without creating the GUI.
+// The first error stops the run, and its code is returned.
+int run_headless(int argc, char *argv[])
+{
+	QStringList inputs;
+	QString output;
+	Algorithm algorithm = INCREMENTAL;
+	bool interior_culling = false;
+	bool duplicate_removal = false;
+	double duplicate_tolerance = 0;
+	bool single_conflict = false;
+	bool spatial_order = false;
+	int streaming_chunk = 0;
+	double approximation = 0;
+	bool union_hull = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		QString arg = QString::fromLocal8Bit(argv[i]);
+
+		if (arg == "-o")
+		{
+			if (++i == argc)
+			{
+				print_usage(argv[0]);
+				return EXIT_USAGE;
+			}
+			output = QString::fromLocal8Bit(argv[i]);
+		}
+		else if (arg == "-a")
+		{
+			QString name = (++i < argc) ? QString::fromLocal8Bit(argv[i]) : QString();
+
+			if (name == "incremental") algorithm = INCREMENTAL;
+			else if (name == "quickhull") algorithm = QUICKHULL;
+			else if (name == "divide") algorithm = DIVIDE_AND_CONQUER;
+			else if (name == "chan") algorithm = CHAN;
+			else
+			{
+				print_usage(argv[0]);
+				return EXIT_USAGE;
+			}
+		}
+		else if (arg == "-c")
+		{
+			interior_culling = true;
+		}
+		else if (arg == "-d")
+		{
+			bool valid = false;
+
+			if (++i < argc) duplicate_tolerance = QString::fromLocal8Bit(argv[i]).toDouble(&valid);
+
+			if (!valid || duplicate_tolerance < 0)
+			{
+				print_usage(argv[0]);
+				return EXIT_USAGE;
+			}
+
+			duplicate_removal = true;
+		}
+		else if (arg == "-s")
+		{
+			single_conflict = true;
+		}
+		else if (arg == "-b")
+		{
+			spatial_order = true;
+		}
+		else if (arg == "-m")
+		{
+			bool valid = false;
+
+			if (++i < argc) streaming_chunk = QString::fromLocal8Bit(argv[i]).toInt(&valid);
+
+			if (!valid || streaming_chunk < STARTING_POINTS)
+			{
+				print_usage(argv[0]);
+				return EXIT_USAGE;
+			}
+		}
+		else if (arg == "-e")
+		{
+			bool valid = false;
+
+			if (++i < argc) approximation = QString::fromLocal8Bit(argv[i]).toDouble(&valid);
+
+			if (!valid || approximation <= 0)
+			{
+				print_usage(argv[0]);
+				return EXIT_USAGE;
+			}
+		}
+		else if (arg == "-u")
+		{
+			union_hull = true;
+		}
+		else if (arg == "-h" || arg == "--help")
+		{
+			print_usage(argv[0]);
+			return EXIT_OK;
+		}
+		else
+		{
+			inputs.append(arg);
+		}
+	}
+
+	if (inputs.isEmpty())
+	{
+		print_usage(argv[0]);
+		return EXIT_USAGE;
+	}
+
+	Engine engine(NULL);
+	engine.set_algorithm(algorithm);
+	engine.set_interior_culling(interior_culling);
+	engine.set_duplicate_removal(duplicate_removal);
+	engine.set_duplicate_tolerance(duplicate_tolerance);
+	engine.set_single_conflict(single_conflict);
+	engine.set_spatial_order(spatial_order);
+	engine.set_streaming(streaming_chunk);
+	engine.set_approximation(approximation);
+	engine.set_union_hull(union_hull);
+
+	// All the inputs are loaded together, and their convex hulls are computed at the same time
+	if (union_hull)
+	{
+		for (int i = 0; i < inputs.size(); i++)
+		{
+			if (!engine.load_file(inputs[i]))
+			{
+				std::cout << "Error loading file " << inputs[i].toStdString() << std::endl;
+				return EXIT_LOAD_ERROR;
+			}
+		}
+
+		if (!engine.calculate_ch())
+		{
+			std::cout << "Error computing the convex hull of the union of the inputs" << std::endl;
+			return EXIT_HULL_ERROR;
+		}
+
+		QString output_file = output.isNull() ? QFileInfo(inputs[0]).dir().filePath("union_hull.off") : output;
+
+		if (!engine.write_file(output_file))
+		{
+			std::cout << "Error saving file " << output_file.toStdString() << std::endl;
+			return EXIT_SAVE_ERROR;
+		}
+
+		return EXIT_OK;
+	}
+
+	for (int i = 0; i < inputs.size(); i++)
+	{
+		QFileInfo input_info(inputs[i]);
+		QString hull_name = input_info.completeBaseName() + "_hull.off";
+		QString output_file;
+
+		if (output.isNull())
+			output_file = input_info.dir().filePath(hull_name);
+		else if (inputs.size() > 1)
+			output_file = QDir(output).filePath(hull_name);
+		else
+			output_file = output;
+
+		engine.reset();
+
+		if (!engine.load_file(inputs[i]))
+		{
+			std::cout << "Error loading file " << inputs[i].toStdString() << std::endl;
+			return EXIT_LOAD_ERROR;
+		}
+
+		if (!engine.calculate_ch())
+		{
+			std::cout << "Error computing the convex hull of " << inputs[i].toStdString() << std::endl;
+			return EXIT_HULL_ERROR;
+		}
+
+		if (!engine.write_file(output_file))
+		{
+			std::cout << "Error saving file " << output_file.toStdString() << std::endl;
+			return EXIT_SAVE_ERROR;
+		}
+	}
+
+	return EXIT_OK;
+}
+
 int main(int argc, char *argv[])
 {
+	// Any argument switches to the command line mode: no GUI, no GL context
+	if (argc > 1) return run_headless(argc, argv);
+
 	QApplication app(argc, argv);
 	QWidget container;
 	container.resize(640, 680);
@@ -78,6 +294,56 @@ int main(int argc, char *argv[])
 	QAction calc("&Calculate CH", &container);
 	calc.setShortcut(QKeySequence(Qt::CTRL + Qt::Key_C));
 	convex_hull.addAction(&calc);
+	convex_hull.addSeparator();
+
+	QActionGroup algorithms(&container);
+
+	QAction incremental("&Incremental", &container);
+	incremental.setCheckable(true);
+	incremental.setChecked(true);
+	algorithms.addAction(&incremental);
+	convex_hull.addAction(&incremental);
+
+	QAction quickhull("&Quickhull", &container);
+	quickhull.setCheckable(true);
+	algorithms.addAction(&quickhull);
+	convex_hull.addAction(&quickhull);
+
+	QAction divide_and_conquer("&Divide and conquer", &container);
+	divide_and_conquer.setCheckable(true);
+	algorithms.addAction(&divide_and_conquer);
+	convex_hull.addAction(&divide_and_conquer);
+
+	QAction chan("&Output sensitive (Chan)", &container);
+	chan.setCheckable(true);
+	algorithms.addAction(&chan);
+	convex_hull.addAction(&chan);
+	convex_hull.addSeparator();
+
+	QAction interior_culling("&Discard interior points", &container);
+	interior_culling.setCheckable(true);
+	convex_hull.addAction(&interior_culling);
+
+	QAction duplicate_removal("Remove d&uplicate points", &container);
+	duplicate_removal.setCheckable(true);
+	convex_hull.addAction(&duplicate_removal);
+
+	QAction single_conflict("&Single conflict per point", &container);
+	single_conflict.setCheckable(true);
+	convex_hull.addAction(&single_conflict);
+
+	QAction spatial_order("Spatially coherent &order", &container);
+	spatial_order.setCheckable(true);
+	convex_hull.addAction(&spatial_order);
+	convex_hull.addSeparator();
+
+	QAction all_meshes("Hull of &all the meshes", &container);
+	all_meshes.setCheckable(true);
+	convex_hull.addAction(&all_meshes);
+
+	QAction union_hull("Hull of the u&nion of the meshes", &container);
+	union_hull.setCheckable(true);
+	convex_hull.addAction(&union_hull);
 
 	/**** MENU HELP ****/
 	QMenu help_menu("&?", &container);
@@ -129,6 +395,16 @@ int main(int argc, char *argv[])
 	QObject::connect( &close, SIGNAL(triggered()), &app, SLOT(quit()) );
 	QObject::connect( &engine, SIGNAL(send_dcel(QVector<DCEL>&)), &window, SLOT(add_dcel(QVector<DCEL>&)) );
 	QObject::connect( &calc, SIGNAL(triggered()), &engine, SLOT(calculate_ch()) );
+	QObject::connect( &incremental, SIGNAL(triggered()), &engine, SLOT(set_incremental()) );
+	QObject::connect( &quickhull, SIGNAL(triggered()), &engine, SLOT(set_quickhull()) );
+	QObject::connect( &divide_and_conquer, SIGNAL(triggered()), &engine, SLOT(set_divide_and_conquer()) );
+	QObject::connect( &chan, SIGNAL(triggered()), &engine, SLOT(set_chan()) );
+	QObject::connect( &interior_culling, SIGNAL(toggled(bool)), &engine, SLOT(set_interior_culling(bool)) );
+	QObject::connect( &duplicate_removal, SIGNAL(toggled(bool)), &engine, SLOT(set_duplicate_removal(bool)) );
+	QObject::connect( &single_conflict, SIGNAL(toggled(bool)), &engine, SLOT(set_single_conflict(bool)) );
+	QObject::connect( &spatial_order, SIGNAL(toggled(bool)), &engine, SLOT(set_spatial_order(bool)) );
+	QObject::connect( &all_meshes, SIGNAL(toggled(bool)), &engine, SLOT(set_all_meshes(bool)) );
+	QObject::connect( &union_hull, SIGNAL(toggled(bool)), &engine, SLOT(set_union_hull(bool)) );
 
 	window.setFocus();
 
@@ -0,0 +1,240 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "online_hull.h"
+#include <algorithm>
+#include <QWriteLocker>
+#include <QReadLocker>
+#include "predicates.h"
+#include "point_block.h"
+
+online_hull::online_hull()
+{
+    started = false;
+}
+
+bool online_hull::insert(const QVector<vertex> &new_points)
+{
+    QWriteLocker locker(&lock);
+    
+    if (!started) {
+        
+        waiting_points += new_points;
+        
+        return start();
+    }
+    
+    QVector<vertex> batch = new_points;
+    insert_batch(batch);
+    
+    return true;
+}
+
+DCEL online_hull::snapshot()
+{
+    QReadLocker locker(&lock);
+    
+    DCEL hull = convex_hull;
+    hull.compact();
+    
+    return hull;
+}
+
+// Build the tethraedron spanned by the extreme points received so far, and insert the other points as the first batch.
+// Return false if the points don't span a volume yet.
+bool online_hull::start(void)
+{
+    int p0, p1, p2, p3;
+    
+    if (!find_extreme_tethraedron(waiting_points, p0, p1, p2, p3)) {
+        
+        return false;
+    }
+    
+    double orientation = orient3d(waiting_points[p0].coord, waiting_points[p1].coord, waiting_points[p2].coord, waiting_points[p3].coord);
+    
+    if (orientation == 0) {
+        
+        return false;
+    }
+    
+    int v0 = convex_hull.add_vertex(waiting_points[p0]);
+    int v1 = convex_hull.add_vertex(waiting_points[p1]);
+    int v2 = convex_hull.add_vertex(waiting_points[p2]);
+    int v3 = convex_hull.add_vertex(waiting_points[p3]);
+    
+    // As in the other algorithms, the faces have to be in clockwise sense from outside
+    if (orientation > 0) {
+        
+        create_tethraedron(convex_hull, v0, v2, v1, v3);
+    } else {
+        
+        create_tethraedron(convex_hull, v0, v1, v2, v3);
+    }
+    
+    QVector<vertex> batch;
+    
+    for (int i = 0; i < waiting_points.size(); i++) {
+        
+        if (i != p0 && i != p1 && i != p2 && i != p3) {
+            
+            batch.append(waiting_points[i]);
+        }
+    }
+    
+    waiting_points.clear();
+    started = true;
+    
+    // The centroid of the tethraedron is inside it, unless rounding it to float moved it out of a very flat tethraedron
+    CGPointf vertexes[STARTING_POINTS] = {convex_hull.get_vertex(v0).coord, convex_hull.get_vertex(v1).coord,
+                                          convex_hull.get_vertex(v2).coord, convex_hull.get_vertex(v3).coord};
+    
+    center.x = ((double)vertexes[0].x + vertexes[1].x + vertexes[2].x + vertexes[3].x) / 4;
+    center.y = ((double)vertexes[0].y + vertexes[1].y + vertexes[2].y + vertexes[3].y) / 4;
+    center.z = ((double)vertexes[0].z + vertexes[1].z + vertexes[2].z + vertexes[3].z) / 4;
+    
+    center_inside = true;
+    
+    for (int i = 0; i < convex_hull.get_faces_n(); i++) {
+        
+        if (plane_distance(convex_hull.get_face_plane(i), center) >= 0) {
+            
+            center_inside = false;
+        }
+    }
+    
+    insert_batch(batch);
+    
+    return true;
+}
+
+// Find the faces of the convex hull visible from each point of the batch, then insert the points as the incremental algorithm does.
+void online_hull::insert_batch(QVector<vertex> &batch)
+{
+    // The points may come in spatial order, as from a scanner, so they are shuffled for the expected cost of the random order
+    std::shuffle(batch.begin(), batch.end(), random_engine);
+    
+    if (spatial_order) {
+        
+        sort_in_rounds(batch, 0);
+    }
+    
+    points.assign(batch);
+    candidate_mark.fill(0, batch.size());
+    candidate_visit = 0;
+    
+    conf_graph = conflict_graph();
+    
+    for (int i = 0; i < batch.size(); i++) {
+        
+        conf_graph.add_vertex_node(i);
+    }
+    
+    // The faces hidden by the earlier batches get a node too, which stays empty
+    conf_graph.add_face_node(convex_hull.get_faces_n() - 1);
+    
+    // The last face created is on the convex hull, as no later point could hide it
+    int face_id = convex_hull.get_faces_n() - 1;
+    
+    for (int i = 0; i < batch.size(); i++) {
+        
+        // The point is inside the convex hull
+        if (!locate_face(batch[i], face_id)) {
+            
+            continue;
+        }
+        
+        QVector<int> visible_faces;
+        find_visible_faces(convex_hull, face_id, batch[i], visible_faces);
+        
+        for (int j = 0; j < visible_faces.size(); j++) {
+            
+            conf_graph.create_arch(visible_faces[j], i);
+        }
+    }
+    
+    insert_sequentially(batch, convex_hull, conf_graph, 0);
+    
+    // Every point of the batch has been inserted or is inside the convex hull
+    conf_graph = conflict_graph();
+    points.assign(QVector<vertex>());
+    
+    if (hidden_faces_n > (convex_hull.get_faces_n() - hidden_faces_n) * HIDDEN_FACES_RATIO) {
+        
+        convex_hull.compact();
+        hidden_faces_n = 0;
+    }
+}
+
+// Find a face visible from the point in "face_id", walking from it, and return false if the point is inside the convex hull.
+// The convex hull only grows, so the centroid of the tethraedron is always inside it, and the ray from the centroid to the point
+// crosses a single face: the point is outside if and only if it sees that face. The walk moves across an edge when the ray
+// is on the other side of the plane through the centroid and the edge; if it takes too long, all the faces are tested.
+bool online_hull::locate_face(vertex &point, int &face_id)
+{
+    if (center_inside) {
+        
+        int faces_n = convex_hull.get_faces_n();
+        
+        for (int step = 0; step < faces_n; step++) {
+            
+            int h = convex_hull.get_face(face_id).get_inner_half_edge();
+            int next_face = -1;
+            
+            // Start from a random edge, so the walk can't cycle forever
+            for (int j = random_engine() % 3; j > 0; j--) {
+                
+                h = convex_hull.get_half_edge(h).get_next();
+            }
+            
+            for (int j = 0; j < 3 && next_face == -1; j++) {
+                
+                half_edge real_h = convex_hull.get_half_edge(h);
+                
+                // The faces are clockwise from outside, so the face is on the positive side of each edge plane
+                if (orient3d(center, convex_hull.get_vertex(real_h.get_from_vertex()).coord,
+                             convex_hull.get_vertex(real_h.get_to_vertex()).coord, point.coord) < 0) {
+                    
+                    next_face = convex_hull.get_half_edge(real_h.get_twin()).get_face();
+                }
+                
+                h = real_h.get_next();
+            }
+            
+            // The ray crosses this face
+            if (next_face == -1) {
+                
+                return is_face_visible(convex_hull, face_id, point);
+            }
+            
+            face_id = next_face;
+        }
+    }
+    
+    for (face_id = 0; face_id < convex_hull.get_faces_n(); face_id++) {
+        
+        if (convex_hull.is_face_in_convex_hull(face_id) && is_face_visible(convex_hull, face_id, point)) {
+            
+            return true;
+        }
+    }
+    
+    return false;
+}
@@ -0,0 +1,71 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ONLINE_HULL_H
+#define ONLINE_HULL_H
+
+#include <QReadWriteLock>
+#include "incremental_hull.h"
+
+// Fraction of the faces on the convex hull over which the faces hidden by the batches are dropped from it
+#define HIDDEN_FACES_RATIO 0.5
+
+// Convex hull kept alive between batches of points, for points which arrive over time. Each batch is inserted with the
+// randomized incremental algorithm into the current convex hull: a face visible from each point is located walking the convex
+// hull, and the others are found around it, so a batch costs as much as its points, not as all the points received. Before the first four points which span a volume
+// arrive, the points are kept aside. Between two batches the conflict graph is empty, as every point has been inserted or
+// found inside, so it only lives for a batch. The convex hull is compacted only when the faces hidden by the batches are more
+// than HIDDEN_FACES_RATIO times the faces on it, so the cost of compacting it is spread over the faces hidden.
+// insert() and snapshot() can be called from different threads: a snapshot is always taken between two batches.
+// The single conflict mode of incremental_hull is ignored.
+class online_hull : public incremental_hull
+{
+    public:
+        
+        online_hull();
+        
+        // Add the points to the convex hull. Return false if all the points received so far still don't span a volume.
+        bool insert(const QVector<vertex> &new_points);
+        
+        // Return a copy of the current convex hull, empty if it hasn't been built yet
+        DCEL snapshot();
+        
+    private:
+        
+        bool start(void);
+        void insert_batch(QVector<vertex> &batch);
+        bool locate_face(vertex &point, int &face_id);
+        
+        // Serializes the batches, and keeps the snapshots out of them
+        QReadWriteLock lock;
+        
+        DCEL convex_hull;
+        conflict_graph conf_graph;
+        
+        // Points received before the convex hull could be built
+        QVector<vertex> waiting_points;
+        bool started;
+        
+        // Point inside the convex hull, from which the faces visible from a point are located
+        CGPointf center;
+        bool center_inside;
+};
+
+#endif // ONLINE_HULL_H
@@ -0,0 +1,269 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "point_block.h"
+#include <cmath>
+#include "predicates.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define POINT_BLOCK_AVX2
+#endif
+
+// Relative error bound of the plane test in double precision, as a multiple of the machine epsilon
+#define PLANE_ERROR_BOUND (16 * 1.1102230246251565e-16)
+
+void set_face_plane(face_plane &plane, const CGPointf &vertex0, const CGPointf &vertex1, const CGPointf &vertex2)
+{
+    plane.vertexes[0] = vertex0;
+    plane.vertexes[1] = vertex1;
+    plane.vertexes[2] = vertex2;
+    
+    plane.origin[0] = vertex0.x;
+    plane.origin[1] = vertex0.y;
+    plane.origin[2] = vertex0.z;
+    
+    double u[3] = {(double)vertex2.x - vertex0.x, (double)vertex2.y - vertex0.y, (double)vertex2.z - vertex0.z};
+    double v[3] = {(double)vertex1.x - vertex0.x, (double)vertex1.y - vertex0.y, (double)vertex1.z - vertex0.z};
+    
+    plane.normal[0] = u[1] * v[2] - u[2] * v[1];
+    plane.normal[1] = u[2] * v[0] - u[0] * v[2];
+    plane.normal[2] = u[0] * v[1] - u[1] * v[0];
+    
+    plane.error[0] = PLANE_ERROR_BOUND * (fabs(u[1] * v[2]) + fabs(u[2] * v[1]));
+    plane.error[1] = PLANE_ERROR_BOUND * (fabs(u[2] * v[0]) + fabs(u[0] * v[2]));
+    plane.error[2] = PLANE_ERROR_BOUND * (fabs(u[0] * v[1]) + fabs(u[1] * v[0]));
+}
+
+// Compute normal * (p - origin) in double precision, with orient3d if the result is smaller than its error bound.
+static inline double signed_distance(const face_plane &plane, double x, double y, double z)
+{
+    double dx = x - plane.origin[0];
+    double dy = y - plane.origin[1];
+    double dz = z - plane.origin[2];
+    
+    double distance = plane.normal[0] * dx + plane.normal[1] * dy + plane.normal[2] * dz;
+    double bound = plane.error[0] * fabs(dx) + plane.error[1] * fabs(dy) + plane.error[2] * fabs(dz);
+    
+    if (distance > bound || -distance > bound) {
+        
+        return distance;
+    }
+    
+    CGPointf point;
+    point.x = x;
+    point.y = y;
+    point.z = z;
+    
+    return orient3d(plane.vertexes[0], plane.vertexes[1], plane.vertexes[2], point);
+}
+
+static inline bool sees_face(const face_plane &plane, double x, double y, double z)
+{
+    return signed_distance(plane, x, y, z) > 0;
+}
+
+double plane_distance(const face_plane &plane, const CGPointf &point)
+{
+    return signed_distance(plane, point.x, point.y, point.z);
+}
+
+#ifdef POINT_BLOCK_AVX2
+
+static bool has_avx2()
+{
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    
+    return supported;
+}
+
+// Test four points against a face plane. Return a mask of the points which see the face for sure and, in "uncertain",
+// a mask of the points whose result is smaller than its error bound.
+__attribute__((target("avx2,fma")))
+static inline int test_four_points(const face_plane &plane, __m256d x, __m256d y, __m256d z, int &uncertain)
+{
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    
+    __m256d dx = _mm256_sub_pd(x, _mm256_set1_pd(plane.origin[0]));
+    __m256d dy = _mm256_sub_pd(y, _mm256_set1_pd(plane.origin[1]));
+    __m256d dz = _mm256_sub_pd(z, _mm256_set1_pd(plane.origin[2]));
+    
+    __m256d distance = _mm256_mul_pd(_mm256_set1_pd(plane.normal[0]), dx);
+    distance = _mm256_fmadd_pd(_mm256_set1_pd(plane.normal[1]), dy, distance);
+    distance = _mm256_fmadd_pd(_mm256_set1_pd(plane.normal[2]), dz, distance);
+    
+    __m256d bound = _mm256_mul_pd(_mm256_set1_pd(plane.error[0]), _mm256_andnot_pd(sign_mask, dx));
+    bound = _mm256_fmadd_pd(_mm256_set1_pd(plane.error[1]), _mm256_andnot_pd(sign_mask, dy), bound);
+    bound = _mm256_fmadd_pd(_mm256_set1_pd(plane.error[2]), _mm256_andnot_pd(sign_mask, dz), bound);
+    
+    int visible = _mm256_movemask_pd(_mm256_cmp_pd(distance, bound, _CMP_GT_OQ));
+    int hidden = _mm256_movemask_pd(_mm256_cmp_pd(distance, _mm256_xor_pd(bound, sign_mask), _CMP_LT_OQ));
+    
+    uncertain = ~(visible | hidden) & 0xF;
+    
+    return visible;
+}
+
+__attribute__((target("avx2,fma")))
+static int visible_range_avx2(const face_plane &plane, const double *x, const double *y, const double *z, int begin, int end, int *visible)
+{
+    int visible_n = 0;
+    int i = begin;
+    
+    for (; i + 4 <= end; i += 4) {
+        
+        int uncertain;
+        int mask = test_four_points(plane, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), _mm256_loadu_pd(z + i), uncertain);
+        
+        // The uncertain points are rare, so they are tested one by one
+        for (int j = 0; j < 4; j++) {
+            
+            if ((mask >> j) & 1 || ((uncertain >> j) & 1 && sees_face(plane, x[i + j], y[i + j], z[i + j]))) {
+                
+                visible[visible_n++] = i + j;
+            }
+        }
+    }
+    
+    for (; i < end; i++) {
+        
+        if (sees_face(plane, x[i], y[i], z[i])) {
+            
+            visible[visible_n++] = i;
+        }
+    }
+    
+    return visible_n;
+}
+
+__attribute__((target("avx2,fma")))
+static int visible_list_avx2(const face_plane &plane, const double *x, const double *y, const double *z, const int *points, int points_n, int *visible)
+{
+    int visible_n = 0;
+    int i = 0;
+    
+    for (; i + 4 <= points_n; i += 4) {
+        
+        __m128i indexes = _mm_loadu_si128((const __m128i *)(points + i));
+        
+        int uncertain;
+        int mask = test_four_points(plane, _mm256_i32gather_pd(x, indexes, 8), _mm256_i32gather_pd(y, indexes, 8),
+                                    _mm256_i32gather_pd(z, indexes, 8), uncertain);
+        
+        for (int j = 0; j < 4; j++) {
+            
+            int point = points[i + j];
+            
+            if ((mask >> j) & 1 || ((uncertain >> j) & 1 && sees_face(plane, x[point], y[point], z[point]))) {
+                
+                visible[visible_n++] = point;
+            }
+        }
+    }
+    
+    for (; i < points_n; i++) {
+        
+        int point = points[i];
+        
+        if (sees_face(plane, x[point], y[point], z[point])) {
+            
+            visible[visible_n++] = point;
+        }
+    }
+    
+    return visible_n;
+}
+
+#endif // POINT_BLOCK_AVX2
+
+void point_block::assign(const QVector<vertex> &vertex_list)
+{
+    x.resize(vertex_list.size());
+    y.resize(vertex_list.size());
+    z.resize(vertex_list.size());
+    
+    for (int i = 0; i < vertex_list.size(); i++) {
+        
+        const CGPointf &point = vertex_list.at(i).coord;
+        
+        x[i] = point.x;
+        y[i] = point.y;
+        z[i] = point.z;
+    }
+}
+
+int point_block::size() const
+{
+    return x.size();
+}
+
+int point_block::visible_points(const face_plane &plane, int begin, int end, int *visible) const
+{
+    const double *px = x.constData();
+    const double *py = y.constData();
+    const double *pz = z.constData();
+    
+#ifdef POINT_BLOCK_AVX2
+    if (has_avx2()) {
+        
+        return visible_range_avx2(plane, px, py, pz, begin, end, visible);
+    }
+#endif
+    
+    int visible_n = 0;
+    
+    for (int i = begin; i < end; i++) {
+        
+        if (sees_face(plane, px[i], py[i], pz[i])) {
+            
+            visible[visible_n++] = i;
+        }
+    }
+    
+    return visible_n;
+}
+
+int point_block::visible_points(const face_plane &plane, const int *points, int points_n, int *visible) const
+{
+    const double *px = x.constData();
+    const double *py = y.constData();
+    const double *pz = z.constData();
+    
+#ifdef POINT_BLOCK_AVX2
+    if (has_avx2()) {
+        
+        return visible_list_avx2(plane, px, py, pz, points, points_n, visible);
+    }
+#endif
+    
+    int visible_n = 0;
+    
+    for (int i = 0; i < points_n; i++) {
+        
+        int point = points[i];
+        
+        if (sees_face(plane, px[point], py[point], pz[point])) {
+            
+            visible[visible_n++] = point;
+        }
+    }
+    
+    return visible_n;
+}
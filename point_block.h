@@ -0,0 +1,58 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef POINT_BLOCK_H
+#define POINT_BLOCK_H
+
+#include <QVector>
+#include "dcel/DCEL.hh"
+
+// Compute the plane of the face "vertex0", "vertex1", "vertex2" (see face_plane in dcel/structures.hh).
+void set_face_plane(face_plane &plane, const CGPointf &vertex0, const CGPointf &vertex1, const CGPointf &vertex2);
+
+// Return normal * (point - origin), which is orient3d of the face vertexes and "point": positive if the point sees the face.
+// The dot product is enough when its result is larger than its error bound, else orient3d gives the exact sign.
+double plane_distance(const face_plane &plane, const CGPointf &point);
+
+// Coordinates of a list of points in separate arrays, to test a face against several points with one instruction.
+// The tests use AVX2 if the processor supports it, else a scalar loop. A point is tested in double precision, and
+// only if the result is smaller than its error bound it is tested again with orient3d: the result is always exact.
+class point_block
+{
+    public:
+        
+        void assign(const QVector<vertex> &vertex_list);
+        
+        int size() const;
+        
+        // Write in "visible" the points from "begin" to "end" which see the face, and return their number
+        int visible_points(const face_plane &plane, int begin, int end, int *visible) const;
+        
+        // Write in "visible" the points of the list "points" which see the face, and return their number
+        int visible_points(const face_plane &plane, const int *points, int points_n, int *visible) const;
+        
+    private:
+        
+        QVector<double> x;
+        QVector<double> y;
+        QVector<double> z;
+};
+
+#endif // POINT_BLOCK_H
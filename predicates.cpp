@@ -0,0 +1,299 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "predicates.h"
+#include <cmath>
+
+// The exact arithmetic follows J. R. Shewchuk, "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric
+// Predicates". A number is represented by an expansion: an array of doubles, ordered by increasing magnitude and without
+// overlapping bits, whose sum is the exact value.
+
+// Machine epsilon of the double precision, and the constant to split a double in two halves of 26 bits
+#define EPSILON 1.1102230246251565e-16
+#define SPLITTER 134217729.0
+
+// Bound of the relative error of the determinant computed in double precision
+static const double orient3d_error_bound = (7.0 + 56.0 * EPSILON) * EPSILON;
+
+// x + y = a + b exactly, with x the rounded sum
+static inline void two_sum(double a, double b, double &x, double &y)
+{
+    x = a + b;
+    double b_virtual = x - a;
+    double a_virtual = x - b_virtual;
+    y = (a - a_virtual) + (b - b_virtual);
+}
+
+// x + y = a - b exactly, with x the rounded difference
+static inline void two_diff(double a, double b, double &x, double &y)
+{
+    x = a - b;
+    double b_virtual = a - x;
+    double a_virtual = x + b_virtual;
+    y = (a - a_virtual) + (b_virtual - b);
+}
+
+// hi + lo = a, with both halves of 26 bits
+static inline void split(double a, double &hi, double &lo)
+{
+    double c = SPLITTER * a;
+    double a_big = c - a;
+    hi = c - a_big;
+    lo = a - hi;
+}
+
+// x + y = a * b exactly, with x the rounded product
+static inline void two_product(double a, double b, double &x, double &y)
+{
+    x = a * b;
+    
+    double a_hi, a_lo, b_hi, b_lo;
+    split(a, a_hi, a_lo);
+    split(b, b_hi, b_lo);
+    
+    double error1 = x - (a_hi * b_hi);
+    double error2 = error1 - (a_lo * b_hi);
+    double error3 = error2 - (a_hi * b_lo);
+    y = (a_lo * b_lo) - error3;
+}
+
+// h = e + b, without zero components. "h" can be "e", and needs one more component than it.
+static int grow_expansion(int e_length, const double *e, double b, double *h)
+{
+    int h_length = 0;
+    double q = b;
+    
+    for (int i = 0; i < e_length; i++) {
+        
+        double h_component;
+        two_sum(q, e[i], q, h_component);
+        
+        if (h_component != 0) {
+            
+            h[h_length++] = h_component;
+        }
+    }
+    
+    if (q != 0 || h_length == 0) {
+        
+        h[h_length++] = q;
+    }
+    
+    return h_length;
+}
+
+// h = e + f, without zero components. "h" can't be "f", and needs as many components as "e" and "f" together.
+static int expansion_sum(int e_length, const double *e, int f_length, const double *f, double *h)
+{
+    int h_length = e_length;
+    
+    for (int i = 0; i < e_length; i++) {
+        
+        h[i] = e[i];
+    }
+    
+    for (int i = 0; i < f_length; i++) {
+        
+        h_length = grow_expansion(h_length, h, f[i], h);
+    }
+    
+    return h_length;
+}
+
+// h = e * b, without zero components. "h" needs twice the components of "e".
+static int scale_expansion(int e_length, const double *e, double b, double *h)
+{
+    int h_length = 0;
+    double q, h_component;
+    
+    two_product(e[0], b, q, h_component);
+    
+    if (h_component != 0) {
+        
+        h[h_length++] = h_component;
+    }
+    
+    for (int i = 1; i < e_length; i++) {
+        
+        double product, product_tail, sum;
+        two_product(e[i], b, product, product_tail);
+        
+        two_sum(q, product_tail, sum, h_component);
+        
+        if (h_component != 0) {
+            
+            h[h_length++] = h_component;
+        }
+        
+        two_sum(product, sum, q, h_component);
+        
+        if (h_component != 0) {
+            
+            h[h_length++] = h_component;
+        }
+    }
+    
+    if (q != 0 || h_length == 0) {
+        
+        h[h_length++] = q;
+    }
+    
+    return h_length;
+}
+
+// h = a * b, for two expansions of at most two components. "h" needs 8 components.
+static int two_by_two_product(int a_length, const double *a, int b_length, const double *b, double *h)
+{
+    double scaled[4];
+    double partial[8];
+    
+    int h_length = scale_expansion(a_length, a, b[0], h);
+    
+    for (int i = 1; i < b_length; i++) {
+        
+        int scaled_length = scale_expansion(a_length, a, b[i], scaled);
+        
+        h_length = expansion_sum(h_length, h, scaled_length, scaled, partial);
+        
+        for (int j = 0; j < h_length; j++) {
+            
+            h[j] = partial[j];
+        }
+    }
+    
+    return h_length;
+}
+
+// Exact difference of two coordinates, as an expansion of at most two components
+static int coordinate_difference(float a, float b, double *h)
+{
+    double head, tail;
+    two_diff(a, b, head, tail);
+    
+    if (tail == 0) {
+        
+        h[0] = head;
+        return 1;
+    }
+    
+    h[0] = tail;
+    h[1] = head;
+    return 2;
+}
+
+// Exact value of z * (x1 * y1 - x2 * y2), with the differences of coordinates as expansions. "h" needs 64 components.
+static int cofactor_product(int z_length, const double *z, int x1_length, const double *x1, int y1_length, const double *y1,
+                            int x2_length, const double *x2, int y2_length, const double *y2, double *h)
+{
+    double product1[8], product2[8], minor[16], scaled[32], partial[64];
+    
+    int product1_length = two_by_two_product(x1_length, x1, y1_length, y1, product1);
+    int product2_length = two_by_two_product(x2_length, x2, y2_length, y2, product2);
+    
+    for (int i = 0; i < product2_length; i++) {
+        
+        product2[i] = -product2[i];
+    }
+    
+    int minor_length = expansion_sum(product1_length, product1, product2_length, product2, minor);
+    
+    int h_length = scale_expansion(minor_length, minor, z[0], h);
+    
+    if (z_length == 2) {
+        
+        int scaled_length = scale_expansion(minor_length, minor, z[1], scaled);
+        
+        h_length = expansion_sum(h_length, h, scaled_length, scaled, partial);
+        
+        for (int i = 0; i < h_length; i++) {
+            
+            h[i] = partial[i];
+        }
+    }
+    
+    return h_length;
+}
+
+// Compute the orientation determinant with exact arithmetic, and return an approximation of it with the exact sign.
+static double orient3d_exact(const CGPointf &a, const CGPointf &b, const CGPointf &c, const CGPointf &d)
+{
+    double adx[2], ady[2], adz[2], bdx[2], bdy[2], bdz[2], cdx[2], cdy[2], cdz[2];
+    
+    int adx_length = coordinate_difference(a.x, d.x, adx);
+    int ady_length = coordinate_difference(a.y, d.y, ady);
+    int adz_length = coordinate_difference(a.z, d.z, adz);
+    int bdx_length = coordinate_difference(b.x, d.x, bdx);
+    int bdy_length = coordinate_difference(b.y, d.y, bdy);
+    int bdz_length = coordinate_difference(b.z, d.z, bdz);
+    int cdx_length = coordinate_difference(c.x, d.x, cdx);
+    int cdy_length = coordinate_difference(c.y, d.y, cdy);
+    int cdz_length = coordinate_difference(c.z, d.z, cdz);
+    
+    double a_term[64], b_term[64], c_term[64], ab_terms[128], determinant[192];
+    
+    int a_length = cofactor_product(adz_length, adz, bdx_length, bdx, cdy_length, cdy, cdx_length, cdx, bdy_length, bdy, a_term);
+    int b_length = cofactor_product(bdz_length, bdz, cdx_length, cdx, ady_length, ady, adx_length, adx, cdy_length, cdy, b_term);
+    int c_length = cofactor_product(cdz_length, cdz, adx_length, adx, bdy_length, bdy, bdx_length, bdx, ady_length, ady, c_term);
+    
+    int ab_length = expansion_sum(a_length, a_term, b_length, b_term, ab_terms);
+    int determinant_length = expansion_sum(ab_length, ab_terms, c_length, c_term, determinant);
+    
+    // The sum of the components, from the smallest, approximates the exact value and has its sign
+    double approximation = 0;
+    
+    for (int i = 0; i < determinant_length; i++) {
+        
+        approximation += determinant[i];
+    }
+    
+    return approximation;
+}
+
+double orient3d(const CGPointf &a, const CGPointf &b, const CGPointf &c, const CGPointf &d)
+{
+    double adx = (double)a.x - d.x, ady = (double)a.y - d.y, adz = (double)a.z - d.z;
+    double bdx = (double)b.x - d.x, bdy = (double)b.y - d.y, bdz = (double)b.z - d.z;
+    double cdx = (double)c.x - d.x, cdy = (double)c.y - d.y, cdz = (double)c.z - d.z;
+    
+    double bdx_cdy = bdx * cdy;
+    double cdx_bdy = cdx * bdy;
+    
+    double cdx_ady = cdx * ady;
+    double adx_cdy = adx * cdy;
+    
+    double adx_bdy = adx * bdy;
+    double bdx_ady = bdx * ady;
+    
+    double determinant = adz * (bdx_cdy - cdx_bdy) + bdz * (cdx_ady - adx_cdy) + cdz * (adx_bdy - bdx_ady);
+    
+    double permanent = (fabs(bdx_cdy) + fabs(cdx_bdy)) * fabs(adz) +
+                       (fabs(cdx_ady) + fabs(adx_cdy)) * fabs(bdz) +
+                       (fabs(adx_bdy) + fabs(bdx_ady)) * fabs(cdz);
+    
+    double error_bound = orient3d_error_bound * permanent;
+    
+    // The sign is certain if the determinant is larger than the rounding errors
+    if (determinant > error_bound || -determinant > error_bound) {
+        
+        return determinant;
+    }
+    
+    return orient3d_exact(a, b, c, d);
+}
@@ -0,0 +1,35 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PREDICATES_H
+#define PREDICATES_H
+
+#include "dcel/DCEL.hh"
+
+// Orientation of the point "d" with respect to the plane through "a", "b" and "c": the determinant of the rows a - d, b - d
+// and c - d, which is positive if "d" sees "a", "b" and "c" in clockwise sense, negative if it sees them in counterclockwise
+// sense and zero if the four points are coplanar. It is equal to the determinant of the 4x4 matrix of the rows (a, 1), (b, 1),
+// (c, 1) and (d, 1).
+// The determinant is computed in double precision, and its sign is checked against a bound of the rounding errors. Only if the
+// sign is uncertain, the determinant is computed again with exact arithmetic: the sign is always correct, and the value
+// returned approximates the exact one. It only reads its arguments, so it can be called from several threads.
+double orient3d(const CGPointf &a, const CGPointf &b, const CGPointf &c, const CGPointf &d);
+
+#endif // PREDICATES_H
@@ -0,0 +1,192 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "quickhull.h"
+#include "predicates.h"
+
+bool quickhull::calculate(QVector<vertex> &vertex_list, DCEL &convex_hull)
+{
+    return calculate(static_cast<const QVector<vertex> &>(vertex_list), convex_hull);
+}
+
+bool quickhull::calculate(const QVector<vertex> &vertex_list, DCEL &convex_hull)
+{
+    int p0, p1, p2, p3;
+    
+    // Start from the tethraedron spanned by the extreme points
+    if (!find_extreme_tethraedron(vertex_list, p0, p1, p2, p3)) {
+        
+        return false;
+    }
+    
+    double orientation = orient3d(vertex_list[p0].coord, vertex_list[p1].coord, vertex_list[p2].coord, vertex_list[p3].coord);
+    
+    // The extreme points are chosen in floating point, so check that they really span a volume
+    if (orientation == 0) {
+        
+        return false;
+    }
+    
+    int v0 = convex_hull.add_vertex(vertex_list[p0]);
+    int v1 = convex_hull.add_vertex(vertex_list[p1]);
+    int v2 = convex_hull.add_vertex(vertex_list[p2]);
+    int v3 = convex_hull.add_vertex(vertex_list[p3]);
+    
+    // As in the incremental algorithm, the faces have to be in clockwise sense from outside
+    if (orientation > 0) {
+        
+        create_tethraedron(convex_hull, v0, v2, v1, v3);
+    } else {
+        
+        create_tethraedron(convex_hull, v0, v1, v2, v3);
+    }
+    
+    outside_set.clear();
+    farthest_point.clear();
+    farthest_determinant.clear();
+    
+    outside_set.resize(convex_hull.get_faces_n());
+    farthest_point.fill(-1, convex_hull.get_faces_n());
+    farthest_determinant.fill(0, convex_hull.get_faces_n());
+    
+    // Assign each point to the first face of the tethraedron it can see. Points which can't see any face are inside.
+    for (int i = 0; i < vertex_list.size(); i++) {
+        
+        if (i == p0 || i == p1 || i == p2 || i == p3) {
+            
+            continue;
+        }
+        
+        for (int j = 0; j < convex_hull.get_faces_n(); j++) {
+            
+            double determinant = visibility_determinant(convex_hull, j, vertex_list[i]);
+            
+            if (determinant > 0) {
+                
+                add_to_outside_set(j, i, determinant);
+                break;
+            }
+        }
+    }
+    
+    // Faces with a non empty outside set
+    QVector<int> pending_faces;
+    
+    for (int i = 0; i < convex_hull.get_faces_n(); i++) {
+        
+        if (!outside_set[i].isEmpty()) {
+            
+            pending_faces.append(i);
+        }
+    }
+    
+    while (!pending_faces.isEmpty()) {
+        
+        int face_id = pending_faces.takeLast();
+        
+        // Skip the faces removed from the convex hull after they were queued
+        if (!convex_hull.is_face_in_convex_hull(face_id) || outside_set[face_id].isEmpty()) {
+            
+            continue;
+        }
+        
+        // Insert the farthest point of the face
+        int eye = farthest_point[face_id];
+        
+        QVector<int> visible_faces;
+        QVector<int> horizon_edges;
+        QVector<int> edges_to_set_twin;
+        QVector<int> new_faces;
+        
+        find_visible_faces(convex_hull, face_id, vertex_list[eye], visible_faces);
+        
+        int new_vertex = convex_hull.add_vertex(vertex_list[eye]);
+        
+        // Find horizon edges, and hide the faces, half-edges and vertexes inside them
+        find_horizon(convex_hull, visible_faces, horizon_edges);
+        hide_visible_region(convex_hull, visible_faces, horizon_edges);
+        
+        // Create a new face for each horizon edge
+        for (int j = 0; j < horizon_edges.size(); j++) {
+            
+            new_faces.append(create_cone_face(convex_hull, horizon_edges[j], new_vertex, edges_to_set_twin));
+        }
+        
+        set_correct_twin(convex_hull, edges_to_set_twin);
+        
+        outside_set.resize(convex_hull.get_faces_n());
+        farthest_point.resize(convex_hull.get_faces_n());
+        farthest_determinant.resize(convex_hull.get_faces_n());
+        
+        for (int j = 0; j < new_faces.size(); j++) {
+            
+            farthest_point[new_faces[j]] = -1;
+            farthest_determinant[new_faces[j]] = 0;
+        }
+        
+        // The points which could see a removed face can only see the new faces, or they are inside the convex hull
+        for (int j = 0; j < visible_faces.size(); j++) {
+            
+            QVector<int> orphan_points = outside_set[visible_faces[j]];
+            outside_set[visible_faces[j]].clear();
+            
+            for (int k = 0; k < orphan_points.size(); k++) {
+                
+                if (orphan_points[k] == eye) {
+                    
+                    continue;
+                }
+                
+                for (int l = 0; l < new_faces.size(); l++) {
+                    
+                    double determinant = visibility_determinant(convex_hull, new_faces[l], vertex_list[orphan_points[k]]);
+                    
+                    if (determinant > 0) {
+                        
+                        add_to_outside_set(new_faces[l], orphan_points[k], determinant);
+                        break;
+                    }
+                }
+            }
+        }
+        
+        for (int j = 0; j < new_faces.size(); j++) {
+            
+            if (!outside_set[new_faces[j]].isEmpty()) {
+                
+                pending_faces.append(new_faces[j]);
+            }
+        }
+    }
+    
+    return true;
+}
+
+// Add a point to the outside set of a face, and keep track of the farthest one
+void quickhull::add_to_outside_set(int face_id, int point, double determinant)
+{
+    outside_set[face_id].append(point);
+    
+    if (farthest_point[face_id] == -1 || determinant > farthest_determinant[face_id]) {
+        
+        farthest_point[face_id] = point;
+        farthest_determinant[face_id] = determinant;
+    }
+}
@@ -0,0 +1,50 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUICKHULL_H
+#define QUICKHULL_H
+
+#include "hull_algorithm.h"
+
+// Quickhull algorithm: each face of the current convex hull keeps the "outside set" of the points which can see it,
+// and the farthest point of a face is always the next one to be inserted. Points left inside the convex hull are
+// dropped as soon as no new face is visible from them.
+class quickhull : public hull_algorithm
+{
+    public:
+        
+        bool calculate(QVector<vertex> &vertex_list, DCEL &convex_hull);
+        
+        // The points are only read, so a list shared with the caller is never copied
+        bool calculate(const QVector<vertex> &vertex_list, DCEL &convex_hull);
+        
+    private:
+        
+        void add_to_outside_set(int face_id, int point, double determinant);
+        
+        // Points which can see each face
+        QVector<QVector<int> > outside_set;
+        
+        // Farthest point of each outside set, with its visibility determinant
+        QVector<int> farthest_point;
+        QVector<double> farthest_determinant;
+};
+
+#endif // QUICKHULL_H
@@ -0,0 +1,123 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "small_hull.h"
+#include "predicates.h"
+#include "point_block.h"
+
+bool small_hull::calculate(QVector<vertex> &vertex_list, DCEL &convex_hull)
+{
+    return calculate(static_cast<const QVector<vertex> &>(vertex_list), convex_hull);
+}
+
+bool small_hull::calculate(const QVector<vertex> &vertex_list, DCEL &convex_hull)
+{
+    int p0, p1, p2, p3;
+    
+    if (!find_extreme_tethraedron(vertex_list, p0, p1, p2, p3)) {
+        
+        return false;
+    }
+    
+    double orientation = orient3d(vertex_list[p0].coord, vertex_list[p1].coord, vertex_list[p2].coord, vertex_list[p3].coord);
+    
+    if (orientation == 0) {
+        
+        return false;
+    }
+    
+    int v0 = convex_hull.add_vertex(vertex_list[p0]);
+    int v1 = convex_hull.add_vertex(vertex_list[p1]);
+    int v2 = convex_hull.add_vertex(vertex_list[p2]);
+    int v3 = convex_hull.add_vertex(vertex_list[p3]);
+    
+    // The faces have to be in clockwise sense from outside
+    if (orientation > 0) {
+        
+        create_tethraedron(convex_hull, v0, v2, v1, v3);
+    } else {
+        
+        create_tethraedron(convex_hull, v0, v1, v2, v3);
+    }
+    
+    hull_faces.clear();
+    
+    for (int i = 0; i < convex_hull.get_faces_n(); i++) {
+        
+        hull_faces.append(i);
+    }
+    
+    for (int i = 0; i < vertex_list.size(); i++) {
+        
+        if (i == p0 || i == p1 || i == p2 || i == p3) {
+            
+            continue;
+        }
+        
+        // Scan the faces for one visible from the point: if there is none, the point is inside
+        int face_id = -1;
+        
+        for (int j = 0; j < hull_faces.size(); j++) {
+            
+            if (plane_distance(convex_hull.get_face_plane(hull_faces[j]), vertex_list[i].coord) > 0) {
+                
+                face_id = hull_faces[j];
+                break;
+            }
+        }
+        
+        if (face_id == -1) {
+            
+            continue;
+        }
+        
+        visible_faces.clear();
+        horizon_edges.clear();
+        
+        find_visible_faces(convex_hull, face_id, vertex_list[i], visible_faces);
+        
+        int new_vertex = convex_hull.add_vertex(vertex_list[i]);
+        
+        find_horizon(convex_hull, visible_faces, horizon_edges);
+        hide_visible_region(convex_hull, visible_faces, horizon_edges);
+        
+        // Replace the visible faces with the new ones in the list of the faces on the convex hull
+        int kept = 0;
+        
+        for (int j = 0; j < hull_faces.size(); j++) {
+            
+            if (convex_hull.is_face_in_convex_hull(hull_faces[j])) {
+                
+                hull_faces[kept++] = hull_faces[j];
+            }
+        }
+        
+        hull_faces.resize(kept);
+        
+        for (int j = 0; j < horizon_edges.size(); j++) {
+            
+            hull_faces.append(create_cone_face(convex_hull, horizon_edges[j], new_vertex, edges_to_set_twin));
+        }
+        
+        set_correct_twin(convex_hull, edges_to_set_twin);
+    }
+    
+    return true;
+}
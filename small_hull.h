@@ -0,0 +1,52 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SMALL_HULL_H
+#define SMALL_HULL_H
+
+#include "hull_algorithm.h"
+
+// Largest set of points sent to small_hull by the batch computation
+#define SMALL_HULL_POINTS 64
+
+// Convex hull of a few points without any bookkeeping: starting from the extreme tethraedron, each point is inserted
+// after a scan of the faces on the convex hull for one it can see. The cost is O(n^2), but there are no conflict lists to allocate
+// and no random numbers, so for a few tens of points it is faster than the other algorithms.
+class small_hull : public hull_algorithm
+{
+    public:
+        
+        bool calculate(QVector<vertex> &vertex_list, DCEL &convex_hull);
+        
+        // The points are only read, so a list shared with the caller is never copied
+        bool calculate(const QVector<vertex> &vertex_list, DCEL &convex_hull);
+        
+    private:
+        
+        // Faces on the convex hull, scanned for each point
+        QVector<int> hull_faces;
+        
+        // Visible region of the point being inserted and the cone which replaces it, kept between the calls
+        QVector<int> visible_faces;
+        QVector<int> horizon_edges;
+        QVector<int> edges_to_set_twin;
+};
+
+#endif // SMALL_HULL_H
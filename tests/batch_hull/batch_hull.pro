@@ -0,0 +1,5 @@
+TARGET = tst_batch_hull
+
+include(../common.pri)
+
+SOURCES += tst_batch_hull.cpp
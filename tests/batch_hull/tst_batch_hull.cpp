@@ -0,0 +1,149 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtTest>
+#include <cmath>
+#include "batch_hull.h"
+#include "incremental_hull.h"
+#include "test_points.h"
+
+class test_batch_hull : public QObject
+{
+    Q_OBJECT
+    
+    private slots:
+        
+        void same_as_single_sets();
+        void flat_sets();
+};
+
+// Points on the unit sphere, all of them on the convex hull
+static QVector<vertex> random_sphere(int points_n, unsigned int seed)
+{
+    QVector<vertex> points = random_ball(points_n, seed);
+    
+    for (int i = 0; i < points.size(); i++) {
+        
+        CGPointf coord = points[i].coord;
+        double length = std::sqrt((double)coord.x * coord.x + (double)coord.y * coord.y + (double)coord.z * coord.z);
+        
+        points[i] = make_vertex(coord.x / length, coord.y / length, coord.z / length);
+    }
+    
+    return points;
+}
+
+// Sets on both sides of SMALL_HULL_POINTS, each one compared with the convex hull computed alone by the incremental algorithm
+void test_batch_hull::same_as_single_sets()
+{
+    const int sizes[] = {4, 5, 20, SMALL_HULL_POINTS - 1, SMALL_HULL_POINTS, SMALL_HULL_POINTS + 1, 200, 2000};
+    QVector< QVector<vertex> > point_sets;
+    
+    for (int round = 0; round < 8; round++) {
+        
+        for (unsigned int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            
+            unsigned int seed = round * 100 + i;
+            point_sets.append(round % 2 ? random_sphere(sizes[i], seed) : random_ball(sizes[i], seed));
+        }
+    }
+    
+    QVector<DCEL> hulls;
+    batch_hull batch;
+    
+    QCOMPARE(batch.calculate(point_sets, hulls), point_sets.size());
+    QCOMPARE(hulls.size(), point_sets.size());
+    
+    for (int i = 0; i < point_sets.size(); i++) {
+        
+        QVector<vertex> points = point_sets[i];
+        DCEL expected;
+        incremental_hull single;
+        
+        QVERIFY(single.calculate(points, expected));
+        QVERIFY(same_hull(hulls[i], expected));
+        
+        // Only the elements on the convex hull are kept
+        QCOMPARE(hulls[i].get_vertex_n(), hull_coords(hulls[i]).size());
+    }
+}
+
+// The sets which don't span a volume get an empty DCEL, between sets which do
+void test_batch_hull::flat_sets()
+{
+    QVector< QVector<vertex> > point_sets;
+    
+    // Coplanar points, both under and over SMALL_HULL_POINTS
+    for (int size = 30; size <= 300; size += 270) {
+        
+        QVector<vertex> flat;
+        
+        for (int i = 0; i < size; i++) {
+            
+            flat.append(make_vertex(i % 7, i / 7, 0.5 * (i % 7) - 2 * (i / 7)));
+        }
+        
+        point_sets.append(random_ball(50, size));
+        point_sets.append(flat);
+    }
+    
+    // Too few points, and collinear points
+    QVector<vertex> few;
+    QVector<vertex> collinear;
+    
+    few.append(make_vertex(0, 0, 0));
+    few.append(make_vertex(1, 0, 0));
+    few.append(make_vertex(0, 1, 0));
+    
+    for (int i = 0; i < 10; i++) {
+        
+        collinear.append(make_vertex(i, 2 * i, 3 * i));
+    }
+    
+    point_sets.append(few);
+    point_sets.append(collinear);
+    point_sets.append(random_ball(500, 7));
+    
+    QVector<DCEL> hulls;
+    batch_hull batch;
+    
+    QCOMPARE(batch.calculate(point_sets, hulls), 3);
+    
+    for (int i = 0; i < point_sets.size(); i++) {
+        
+        QVector<vertex> points = point_sets[i];
+        DCEL expected;
+        incremental_hull single;
+        
+        if (single.calculate(points, expected)) {
+            
+            QVERIFY(same_hull(hulls[i], expected));
+        } else {
+            
+            QCOMPARE(hulls[i].get_vertex_n(), 0);
+            QCOMPARE(hulls[i].get_half_edge_n(), 0);
+            QCOMPARE(hulls[i].get_faces_n(), 0);
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(test_batch_hull)
+
+#include "tst_batch_hull.moc"
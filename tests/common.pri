@@ -0,0 +1,37 @@
+# Sources of the hull algorithms shared by the tests, without the engine and the GUI
+
+QT += testlib
+QT -= gui
+greaterThan(QT_MAJOR_VERSION, 4): QT += concurrent
+
+CONFIG += console testcase c++11
+CONFIG -= app_bundle
+
+ROOT = $$PWD/..
+
+DEPENDPATH += $$PWD $$ROOT $$ROOT/dcel
+INCLUDEPATH += $$PWD $$ROOT $$ROOT/dcel
+
+HEADERS += \
+    $$PWD/test_points.h
+
+SOURCES += \
+    $$ROOT/dcel/DCEL.cpp \
+    $$ROOT/conflict_node.cpp \
+    $$ROOT/conflict_graph.cpp \
+    $$ROOT/hull_algorithm.cpp \
+    $$ROOT/incremental_hull.cpp \
+    $$ROOT/online_hull.cpp \
+    $$ROOT/quickhull.cpp \
+    $$ROOT/divide_conquer_hull.cpp \
+    $$ROOT/chan_hull.cpp \
+    $$ROOT/group_hull.cpp \
+    $$ROOT/dynamic_hull.cpp \
+    $$ROOT/small_hull.cpp \
+    $$ROOT/batch_hull.cpp \
+    $$ROOT/interior_culling.cpp \
+    $$ROOT/duplicate_removal.cpp \
+    $$ROOT/epsilon_kernel.cpp \
+    $$ROOT/predicates.cpp \
+    $$ROOT/point_block.cpp \
+    $$ROOT/edge_index.cpp
@@ -0,0 +1,5 @@
+TARGET = tst_divide_conquer_hull
+
+include(../common.pri)
+
+SOURCES += tst_divide_conquer_hull.cpp
@@ -0,0 +1,209 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtTest>
+#include <cmath>
+#include "divide_conquer_hull.h"
+#include "quickhull.h"
+#include "predicates.h"
+#include "test_points.h"
+
+class test_divide_conquer_hull : public QObject
+{
+    Q_OBJECT
+    
+    private slots:
+        
+        void ball();
+        void sphere();
+        void needle();
+        void duplicates();
+        void grid();
+        void flat_points();
+        
+    private:
+        
+        bool check_structure(DCEL &convex_hull);
+        bool same_as_quickhull(const QVector<vertex> &points);
+};
+
+// Each half-edge has a twin in the opposite sense, and the faces around each edge are convex
+bool test_divide_conquer_hull::check_structure(DCEL &convex_hull)
+{
+    for (int i = 0; i < convex_hull.get_half_edge_n(); i++) {
+        
+        half_edge h = convex_hull.get_half_edge(i);
+        half_edge twin = convex_hull.get_half_edge(h.get_twin());
+        half_edge next = convex_hull.get_half_edge(h.get_next());
+        
+        if (twin.get_twin() != i || twin.get_from_vertex() != h.get_to_vertex() || next.get_from_vertex() != h.get_to_vertex()) {
+            
+            return false;
+        }
+        
+        CGPointf a = convex_hull.get_vertex(h.get_from_vertex()).coord;
+        CGPointf b = convex_hull.get_vertex(h.get_to_vertex()).coord;
+        CGPointf c = convex_hull.get_vertex(next.get_to_vertex()).coord;
+        CGPointf opposite = convex_hull.get_vertex(convex_hull.get_half_edge(twin.get_next()).get_to_vertex()).coord;
+        
+        if (orient3d(a, b, c, opposite) > 0) {
+            
+            return false;
+        }
+    }
+    
+    return hull_coords(convex_hull).size() == convex_hull.get_vertex_n();
+}
+
+// Points in general position give the same convex hull of quickhull
+bool test_divide_conquer_hull::same_as_quickhull(const QVector<vertex> &points)
+{
+    QVector<vertex> sorted = points;
+    DCEL convex_hull, expected;
+    divide_conquer_hull hull;
+    quickhull one_shot;
+    
+    return hull.calculate(sorted, convex_hull) && one_shot.calculate(points, expected) && check_structure(convex_hull) &&
+           same_hull(convex_hull, expected);
+}
+
+void test_divide_conquer_hull::ball()
+{
+    QVERIFY(same_as_quickhull(random_ball(20000, 30)));
+}
+
+// All the points are on the convex hull, so each merge wraps a long band
+void test_divide_conquer_hull::sphere()
+{
+    QVector<vertex> points = random_ball(20000, 31);
+    
+    for (int i = 0; i < points.size(); i++) {
+        
+        CGPointf coord = points[i].coord;
+        double length = std::sqrt((double)coord.x * coord.x + (double)coord.y * coord.y + (double)coord.z * coord.z);
+        
+        points[i] = make_vertex(coord.x / length, coord.y / length, coord.z / length);
+    }
+    
+    QVERIFY(same_as_quickhull(points));
+}
+
+// Half a ball and a thin needle along x: the convex hull of the needle is almost all inside the merged one
+void test_divide_conquer_hull::needle()
+{
+    QVector<vertex> points = random_ball(20000, 32);
+    
+    for (int i = 0; i < points.size(); i++) {
+        
+        CGPointf coord = points[i].coord;
+        
+        if (i % 2 == 0) {
+            
+            points[i] = make_vertex(-std::fabs(coord.x), coord.y, coord.z);
+        } else {
+            
+            points[i] = make_vertex(5 * std::fabs(coord.x), coord.y * 0.01, coord.z * 0.01);
+        }
+    }
+    
+    QVERIFY(same_as_quickhull(points));
+}
+
+// Equal points are never split between two halves
+void test_divide_conquer_hull::duplicates()
+{
+    QVector<vertex> points = random_ball(6000, 33);
+    
+    points += points;
+    points += points.mid(0, 3000);
+    
+    QVERIFY(same_as_quickhull(points));
+}
+
+// Points on a grid have many coplanar faces, so the merges fall back to quickhull: the convex hull still contains all the
+// points and has the corners of the grid
+void test_divide_conquer_hull::grid()
+{
+    QVector<vertex> points;
+    
+    for (int i = 0; i < 20; i++) {
+        
+        for (int j = 0; j < 20; j++) {
+            
+            for (int k = 0; k < 20; k++) {
+                
+                points.append(make_vertex(i, j, k));
+            }
+        }
+    }
+    
+    QVector<vertex> sorted = points;
+    DCEL convex_hull;
+    divide_conquer_hull hull;
+    
+    QVERIFY(hull.calculate(sorted, convex_hull));
+    QVERIFY(check_structure(convex_hull));
+    
+    for (int i = 0; i < convex_hull.get_faces_n(); i++) {
+        
+        const face_plane &plane = convex_hull.get_face_plane(i);
+        
+        for (int j = 0; j < points.size(); j++) {
+            
+            QVERIFY(orient3d(plane.vertexes[0], plane.vertexes[1], plane.vertexes[2], points[j].coord) <= 0);
+        }
+    }
+    
+    QVector<CGPointf> coords = hull_coords(convex_hull);
+    
+    for (int i = 0; i < 8; i++) {
+        
+        CGPointf corner((i & 1) * 19, (i >> 1 & 1) * 19, (i >> 2) * 19);
+        bool found = false;
+        
+        for (int j = 0; j < coords.size(); j++) {
+            
+            found = found || (!less_coord(coords[j], corner) && !less_coord(corner, coords[j]));
+        }
+        
+        QVERIFY(found);
+    }
+}
+
+// Points which don't span a volume have no convex hull
+void test_divide_conquer_hull::flat_points()
+{
+    QVector<vertex> points = random_ball(10000, 34);
+    
+    for (int i = 0; i < points.size(); i++) {
+        
+        CGPointf coord = points[i].coord;
+        points[i] = make_vertex(coord.x, coord.y, coord.x);
+    }
+    
+    DCEL convex_hull;
+    divide_conquer_hull hull;
+    
+    QVERIFY(!hull.calculate(points, convex_hull));
+}
+
+QTEST_APPLESS_MAIN(test_divide_conquer_hull)
+
+#include "tst_divide_conquer_hull.moc"
@@ -0,0 +1,5 @@
+TARGET = tst_duplicate_removal
+
+include(../common.pri)
+
+SOURCES += tst_duplicate_removal.cpp
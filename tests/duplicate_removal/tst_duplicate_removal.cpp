@@ -0,0 +1,200 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtTest>
+#include "duplicate_removal.h"
+#include "test_points.h"
+
+class test_duplicate_removal : public QObject
+{
+    Q_OBJECT
+    
+    private slots:
+        
+        void exact_duplicates();
+        void grid_duplicates();
+        void far_cells();
+        void empty_list();
+        
+    private:
+        
+        bool check_mapping(const QVector<vertex> &original, const QVector<vertex> &reduced, duplicate_removal &duplicates);
+};
+
+static bool same_coord(const CGPointf &p1, const CGPointf &p2)
+{
+    return p1.x == p2.x && p1.y == p2.y && p1.z == p2.z;
+}
+
+// Each point kept comes from its position in the original list, in the same order, and each point of the original list
+// maps to a point kept, which is the first one of its group
+bool test_duplicate_removal::check_mapping(const QVector<vertex> &original, const QVector<vertex> &reduced, duplicate_removal &duplicates)
+{
+    const QVector<int> &original_indexes = duplicates.get_original_indexes();
+    const QVector<int> &kept_indexes = duplicates.get_kept_indexes();
+    
+    if (original_indexes.size() != reduced.size() || kept_indexes.size() != original.size()) {
+        
+        return false;
+    }
+    
+    for (int i = 0; i < reduced.size(); i++) {
+        
+        if (!same_coord(reduced[i].coord, original[original_indexes[i]].coord) || kept_indexes[original_indexes[i]] != i) {
+            
+            return false;
+        }
+        
+        if (i > 0 && original_indexes[i] <= original_indexes[i - 1]) {
+            
+            return false;
+        }
+    }
+    
+    for (int i = 0; i < original.size(); i++) {
+        
+        if (kept_indexes[i] < 0 || kept_indexes[i] >= reduced.size() || original_indexes[kept_indexes[i]] > i) {
+            
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+// Each point of a cloud appears from one to four times, in random positions, and -0 is the same as 0
+void test_duplicate_removal::exact_duplicates()
+{
+    QVector<vertex> points = random_ball(1000, 11);
+    std::mt19937 random_engine(12);
+    QVector<int> copies;
+    QVector<vertex> cloud;
+    
+    points[0] = make_vertex(0, 0.5, 0.25);
+    
+    for (int i = 0; i < points.size(); i++) {
+        
+        int copies_n = 1 + random_engine() % 4;
+        
+        for (int j = 0; j < copies_n; j++) {
+            
+            cloud.append(points[i]);
+            copies.append(i);
+        }
+    }
+    
+    cloud.append(make_vertex(-0.0, 0.5, 0.25));
+    copies.append(0);
+    
+    for (int i = cloud.size() - 1; i > 0; i--) {
+        
+        int j = random_engine() % (i + 1);
+        
+        std::swap(cloud[i], cloud[j]);
+        std::swap(copies[i], copies[j]);
+    }
+    
+    QVector<vertex> reduced = cloud;
+    duplicate_removal duplicates;
+    
+    QCOMPARE(duplicates.remove(reduced, 0), cloud.size() - points.size());
+    QCOMPARE(reduced.size(), points.size());
+    QVERIFY(check_mapping(cloud, reduced, duplicates));
+    
+    // The points of a group map to the same point, and the points of different groups to different points
+    const QVector<int> &kept_indexes = duplicates.get_kept_indexes();
+    QVector<int> group_point(points.size(), -1);
+    
+    for (int i = 0; i < cloud.size(); i++) {
+        
+        if (group_point[copies[i]] == -1) {
+            
+            group_point[copies[i]] = kept_indexes[i];
+        }
+        
+        QCOMPARE(kept_indexes[i], group_point[copies[i]]);
+    }
+}
+
+// Points jittered around the centers of the cells of a grid fall in the cell of their center
+void test_duplicate_removal::grid_duplicates()
+{
+    std::mt19937 random_engine(13);
+    std::uniform_real_distribution<double> jitter(-0.2, 0.2);
+    QVector<vertex> cloud;
+    QVector<int> cells;
+    
+    for (int i = 0; i < 3000; i++) {
+        
+        int cell = random_engine() % 125;
+        
+        cloud.append(make_vertex((cell % 5 - 2 + 0.5 + jitter(random_engine)) * 0.1,
+                                 (cell / 5 % 5 - 2 + 0.5 + jitter(random_engine)) * 0.1,
+                                 (cell / 25 - 2 + 0.5 + jitter(random_engine)) * 0.1));
+        cells.append(cell);
+    }
+    
+    QVector<vertex> reduced = cloud;
+    duplicate_removal duplicates;
+    
+    duplicates.remove(reduced, 0.1);
+    
+    QCOMPARE(reduced.size(), 125);
+    QVERIFY(check_mapping(cloud, reduced, duplicates));
+    
+    const QVector<int> &kept_indexes = duplicates.get_kept_indexes();
+    
+    for (int i = 0; i < cloud.size(); i++) {
+        
+        QCOMPARE(cells[duplicates.get_original_indexes()[kept_indexes[i]]], cells[i]);
+    }
+}
+
+// With a tolerance far smaller than the coordinates, the cells are out of the range of the keys: only equal points are removed
+void test_duplicate_removal::far_cells()
+{
+    QVector<vertex> cloud;
+    
+    cloud.append(make_vertex(1e10, 1, 1));
+    cloud.append(make_vertex(1e10, 1, 1));
+    cloud.append(make_vertex(1.0001e10, 1, 1));
+    cloud.append(make_vertex(-1e10, 1, 1));
+    cloud.append(make_vertex(1e10, 1, 1));
+    
+    QVector<vertex> reduced = cloud;
+    duplicate_removal duplicates;
+    
+    QCOMPARE(duplicates.remove(reduced, 1e-30), 2);
+    QVERIFY(check_mapping(cloud, reduced, duplicates));
+}
+
+void test_duplicate_removal::empty_list()
+{
+    QVector<vertex> cloud;
+    duplicate_removal duplicates;
+    
+    QCOMPARE(duplicates.remove(cloud, 0), 0);
+    QVERIFY(duplicates.get_original_indexes().isEmpty());
+    QVERIFY(duplicates.get_kept_indexes().isEmpty());
+}
+
+QTEST_APPLESS_MAIN(test_duplicate_removal)
+
+#include "tst_duplicate_removal.moc"
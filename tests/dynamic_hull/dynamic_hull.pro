@@ -0,0 +1,5 @@
+TARGET = tst_dynamic_hull
+
+include(../common.pri)
+
+SOURCES += tst_dynamic_hull.cpp
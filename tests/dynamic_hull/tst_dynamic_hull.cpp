@@ -0,0 +1,260 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtTest>
+#include "dynamic_hull.h"
+#include "quickhull.h"
+#include "test_points.h"
+
+class test_dynamic_hull : public QObject
+{
+    Q_OBJECT
+    
+    private slots:
+        
+        void sliding_window();
+        void mixed_updates();
+        void removed_before_query();
+        void unknown_points();
+        void flat_points();
+        
+    private:
+        
+        bool check(dynamic_hull &hull, const QHash<int, vertex> &live, unsigned int seed);
+};
+
+// Compare the dynamic hull with a fresh hull of the points not removed: the convex hull, some containment queries and some
+// extreme point queries
+bool test_dynamic_hull::check(dynamic_hull &hull, const QHash<int, vertex> &live, unsigned int seed)
+{
+    QVector<vertex> points;
+    
+    for (QHash<int, vertex>::const_iterator i = live.constBegin(); i != live.constEnd(); ++i) {
+        
+        points.append(i.value());
+    }
+    
+    if (hull.size() != points.size()) {
+        
+        return false;
+    }
+    
+    DCEL expected;
+    quickhull fresh;
+    
+    if (!fresh.calculate(points, expected)) {
+        
+        return false;
+    }
+    
+    DCEL convex_hull;
+    
+    if (!hull.get_convex_hull(convex_hull) || !same_hull(convex_hull, expected)) {
+        
+        return false;
+    }
+    
+    // Points around the unit ball, both inside and outside the convex hull
+    QVector<vertex> queries = random_ball(50, seed);
+    
+    for (int i = 0; i < queries.size(); i++) {
+        
+        CGPointf coord = queries[i].coord;
+        coord.x *= 1.2;
+        coord.y *= 1.2;
+        coord.z *= 1.2;
+        queries[i].set_coord(coord);
+        
+        bool inside = true;
+        
+        for (int j = 0; j < expected.get_faces_n() && inside; j++) {
+            
+            if (expected.is_face_in_convex_hull(j) && plane_distance(expected.get_face_plane(j), coord) > 0) {
+                
+                inside = false;
+            }
+        }
+        
+        if (hull.contains(queries[i]) != inside) {
+            
+            return false;
+        }
+        
+        double direction[3] = {coord.x, coord.y, coord.z};
+        double farthest = -1e300;
+        
+        for (int j = 0; j < points.size(); j++) {
+            
+            const CGPointf &p = points[j].coord;
+            farthest = std::max(farthest, direction[0] * p.x + direction[1] * p.y + direction[2] * p.z);
+        }
+        
+        vertex extreme;
+        
+        if (!hull.extreme_point(direction, extreme)) {
+            
+            return false;
+        }
+        
+        const CGPointf &e = extreme.coord;
+        
+        if (direction[0] * e.x + direction[1] * e.y + direction[2] * e.z != farthest) {
+            
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+// The oldest point leaves as each new one arrives
+void test_dynamic_hull::sliding_window()
+{
+    QVector<vertex> points = random_ball(3000, 1);
+    QVector<int> ids;
+    QHash<int, vertex> live;
+    dynamic_hull hull;
+    
+    for (int i = 0; i < points.size(); i++) {
+        
+        int id = hull.insert(points[i]);
+        ids.append(id);
+        live.insert(id, points[i]);
+        
+        if (i >= 500) {
+            
+            QVERIFY(hull.remove(ids[i - 500]));
+            live.remove(ids[i - 500]);
+        }
+        
+        if (i % 250 == 249) {
+            
+            QVERIFY(check(hull, live, i));
+        }
+    }
+}
+
+// Random insertions and removals of random points, with queries in between, so the merged hull is both updated with the
+// inserted points and built again after a removal
+void test_dynamic_hull::mixed_updates()
+{
+    QVector<vertex> points = random_ball(4000, 2);
+    std::mt19937 random_engine(3);
+    QVector<int> ids;
+    QHash<int, vertex> live;
+    dynamic_hull hull;
+    int next_point = 0;
+    
+    for (int step = 0; step < 6000; step++) {
+        
+        bool insertion = ids.size() < 8 || (next_point < points.size() && random_engine() % 3 != 0);
+        
+        if (insertion && next_point < points.size()) {
+            
+            int id = hull.insert(points[next_point]);
+            ids.append(id);
+            live.insert(id, points[next_point++]);
+        } else if (!ids.isEmpty()) {
+            
+            int position = random_engine() % ids.size();
+            int id = ids[position];
+            
+            ids[position] = ids.last();
+            ids.removeLast();
+            
+            QVERIFY(hull.remove(id));
+            live.remove(id);
+        }
+        
+        if (step % 97 == 0 && ids.size() >= 8) {
+            
+            QVERIFY(check(hull, live, step));
+        }
+    }
+}
+
+// A point outside the convex hull removed before the next query, then one removed after it
+void test_dynamic_hull::removed_before_query()
+{
+    QVector<vertex> points = random_ball(200, 4);
+    QHash<int, vertex> live;
+    dynamic_hull hull;
+    
+    for (int i = 0; i < points.size(); i++) {
+        
+        live.insert(hull.insert(points[i]), points[i]);
+    }
+    
+    QVERIFY(check(hull, live, 5));
+    
+    int id = hull.insert(make_vertex(3, 0, 0));
+    
+    QVERIFY(hull.remove(id));
+    QVERIFY(!hull.contains(make_vertex(2, 0, 0)));
+    QVERIFY(check(hull, live, 6));
+    
+    id = hull.insert(make_vertex(0, 3, 0));
+    
+    QVERIFY(hull.contains(make_vertex(0, 2, 0)));
+    QVERIFY(hull.remove(id));
+    QVERIFY(check(hull, live, 7));
+}
+
+void test_dynamic_hull::unknown_points()
+{
+    dynamic_hull hull;
+    
+    QVERIFY(!hull.remove(0));
+    
+    int id = hull.insert(make_vertex(1, 2, 3));
+    
+    QVERIFY(!hull.remove(id + 1));
+    QVERIFY(hull.remove(id));
+    QVERIFY(!hull.remove(id));
+    QCOMPARE(hull.size(), 0);
+}
+
+// Points on a plane don't span a volume, until a point off the plane arrives
+void test_dynamic_hull::flat_points()
+{
+    dynamic_hull hull;
+    DCEL convex_hull;
+    
+    for (int i = 0; i < 20; i++) {
+        
+        hull.insert(make_vertex(i % 5, i / 5, 0));
+    }
+    
+    QVERIFY(!hull.get_convex_hull(convex_hull));
+    QVERIFY(!hull.contains(make_vertex(1, 1, 0)));
+    
+    int id = hull.insert(make_vertex(2, 2, 1));
+    
+    QVERIFY(hull.get_convex_hull(convex_hull));
+    QVERIFY(hull.contains(make_vertex(2, 2, 0.5)));
+    
+    hull.remove(id);
+    
+    QVERIFY(!hull.get_convex_hull(convex_hull));
+}
+
+QTEST_APPLESS_MAIN(test_dynamic_hull)
+
+#include "tst_dynamic_hull.moc"
@@ -0,0 +1,5 @@
+TARGET = tst_online_hull
+
+include(../common.pri)
+
+SOURCES += tst_online_hull.cpp
@@ -0,0 +1,197 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtTest>
+#include <cmath>
+#include "online_hull.h"
+#include "quickhull.h"
+#include "test_points.h"
+
+class test_online_hull : public QObject
+{
+    Q_OBJECT
+    
+    private slots:
+        
+        void flat_start();
+        void batches();
+        void batches_in_spatial_order();
+        void many_small_batches();
+        
+    private:
+        
+        bool check(online_hull &hull, const QVector<vertex> &received);
+        void insert_batches(online_hull &hull, int batch_size, unsigned int seed);
+};
+
+// Compare the snapshot with the convex hull of all the points received, computed at once
+bool test_online_hull::check(online_hull &hull, const QVector<vertex> &received)
+{
+    QVector<vertex> points = received;
+    DCEL expected;
+    quickhull one_shot;
+    
+    if (!one_shot.calculate(points, expected)) {
+        
+        return false;
+    }
+    
+    DCEL snapshot = hull.snapshot();
+    
+    // The snapshot has only the elements on the convex hull, with their twins on it
+    for (int i = 0; i < snapshot.get_half_edge_n(); i++) {
+        
+        half_edge h = snapshot.get_half_edge(i);
+        
+        if (h.get_twin() < 0 || snapshot.get_half_edge(h.get_twin()).get_twin() != i) {
+            
+            return false;
+        }
+    }
+    
+    return snapshot.get_vertex_n() == hull_coords(snapshot).size() && same_hull(snapshot, expected);
+}
+
+// Batches of new points, each one followed by a batch of points already inside the convex hull
+void test_online_hull::insert_batches(online_hull &hull, int batch_size, unsigned int seed)
+{
+    QVector<vertex> received;
+    QVector<vertex> points = random_ball(20 * batch_size, seed);
+    
+    for (int i = 0; i < points.size(); i += batch_size) {
+        
+        QVector<vertex> batch = points.mid(i, batch_size);
+        
+        QVERIFY(hull.insert(batch));
+        received += batch;
+        
+        QVector<vertex> inside;
+        
+        for (int j = 0; j < batch.size(); j++) {
+            
+            const CGPointf &coord = received[j].coord;
+            inside.append(make_vertex(coord.x * 0.5, coord.y * 0.5, coord.z * 0.5));
+        }
+        
+        QVERIFY(hull.insert(inside));
+        received += inside;
+        
+        QVERIFY(check(hull, received));
+    }
+}
+
+// The points which don't span a volume are kept aside until a point off their plane arrives
+void test_online_hull::flat_start()
+{
+    online_hull hull;
+    QVector<vertex> received;
+    QVector<vertex> flat;
+    
+    QCOMPARE(hull.snapshot().get_faces_n(), 0);
+    
+    flat.append(make_vertex(0, 0, 0));
+    flat.append(make_vertex(1, 0, 0));
+    
+    QVERIFY(!hull.insert(flat));
+    received += flat;
+    
+    flat = random_ball(30, 20);
+    
+    for (int i = 0; i < flat.size(); i++) {
+        
+        CGPointf coord = flat[i].coord;
+        flat[i] = make_vertex(2.5 + 3 * coord.x, 2 + 3 * coord.y, 0);
+    }
+    
+    QVERIFY(!hull.insert(flat));
+    received += flat;
+    
+    QCOMPARE(hull.snapshot().get_faces_n(), 0);
+    
+    QVector<vertex> batch = random_ball(200, 21);
+    
+    for (int i = 0; i < batch.size(); i++) {
+        
+        CGPointf coord = batch[i].coord;
+        batch[i] = make_vertex(2.5 + coord.x, 2 + coord.y, coord.z);
+    }
+    
+    QVERIFY(hull.insert(batch));
+    received += batch;
+    
+    QVERIFY(check(hull, received));
+    
+    batch = random_ball(200, 22);
+    
+    QVERIFY(hull.insert(batch));
+    received += batch;
+    
+    QVERIFY(check(hull, received));
+}
+
+void test_online_hull::batches()
+{
+    online_hull hull;
+    
+    insert_batches(hull, 500, 23);
+}
+
+void test_online_hull::batches_in_spatial_order()
+{
+    online_hull hull;
+    
+    hull.set_spatial_order(true);
+    insert_batches(hull, 500, 24);
+}
+
+// Small batches of points on a sphere, all on the convex hull, so many faces are hidden between the compactions
+void test_online_hull::many_small_batches()
+{
+    online_hull hull;
+    QVector<vertex> received;
+    QVector<vertex> points = random_ball(6000, 25);
+    
+    for (int i = 0; i < points.size(); i++) {
+        
+        CGPointf coord = points[i].coord;
+        double length = std::sqrt((double)coord.x * coord.x + (double)coord.y * coord.y + (double)coord.z * coord.z);
+        
+        points[i] = make_vertex(coord.x / length, coord.y / length, coord.z / length);
+    }
+    
+    for (int i = 0; i < points.size(); i += 20) {
+        
+        QVector<vertex> batch = points.mid(i, 20);
+        
+        QVERIFY(hull.insert(batch));
+        received += batch;
+        
+        if (i % 1000 == 0) {
+            
+            QVERIFY(check(hull, received));
+        }
+    }
+    
+    QVERIFY(check(hull, received));
+}
+
+QTEST_APPLESS_MAIN(test_online_hull)
+
+#include "tst_online_hull.moc"
@@ -0,0 +1,126 @@
+/*
+ *  Convex Hull 3D
+ *  Copyright 2013 Simone Barbieri 
+ * 
+ *  This file is part of Convex Hull 3D.
+ *
+ *  Convex Hull 3D is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Convex Hull 3D is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Convex Hull 3D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_POINTS_H
+#define TEST_POINTS_H
+
+#include <QVector>
+#include <random>
+#include <algorithm>
+#include "dcel/DCEL.hh"
+#include "point_block.h"
+
+// Points and checks shared by the tests
+
+inline vertex make_vertex(double x, double y, double z)
+{
+    vertex point;
+    CGPointf coord;
+    
+    coord.x = x;
+    coord.y = y;
+    coord.z = z;
+    point.set_coord(coord);
+    
+    return point;
+}
+
+// Points uniformly distributed in the unit ball, the same for the same seed
+inline QVector<vertex> random_ball(int points_n, unsigned int seed)
+{
+    std::mt19937 random_engine(seed);
+    std::uniform_real_distribution<double> coordinate(-1, 1);
+    
+    QVector<vertex> points;
+    
+    while (points.size() < points_n) {
+        
+        double x = coordinate(random_engine), y = coordinate(random_engine), z = coordinate(random_engine);
+        
+        if (x * x + y * y + z * z <= 1) {
+            
+            points.append(make_vertex(x, y, z));
+        }
+    }
+    
+    return points;
+}
+
+static inline bool less_coord(const CGPointf &p1, const CGPointf &p2)
+{
+    if (p1.x != p2.x) return p1.x < p2.x;
+    if (p1.y != p2.y) return p1.y < p2.y;
+    
+    return p1.z < p2.z;
+}
+
+// Coordinates of the vertexes on the convex hull, sorted
+inline QVector<CGPointf> hull_coords(DCEL &convex_hull)
+{
+    QVector<CGPointf> coords;
+    
+    for (int i = 0; i < convex_hull.get_vertex_n(); i++) {
+        
+        if (convex_hull.is_vertex_in_convex_hull(i)) {
+            
+            coords.append(convex_hull.get_vertex(i).coord);
+        }
+    }
+    
+    std::sort(coords.begin(), coords.end(), less_coord);
+    
+    return coords;
+}
+
+// Return true if the two convex hulls have the same vertexes and the same number of faces
+inline bool same_hull(DCEL &hull1, DCEL &hull2)
+{
+    QVector<CGPointf> coords1 = hull_coords(hull1);
+    QVector<CGPointf> coords2 = hull_coords(hull2);
+    
+    if (coords1.size() != coords2.size()) {
+        
+        return false;
+    }
+    
+    for (int i = 0; i < coords1.size(); i++) {
+        
+        if (less_coord(coords1[i], coords2[i]) || less_coord(coords2[i], coords1[i])) {
+            
+            return false;
+        }
+    }
+    
+    int faces1 = 0, faces2 = 0;
+    
+    for (int i = 0; i < hull1.get_faces_n(); i++) {
+        
+        faces1 += hull1.is_face_in_convex_hull(i);
+    }
+    
+    for (int i = 0; i < hull2.get_faces_n(); i++) {
+        
+        faces2 += hull2.is_face_in_convex_hull(i);
+    }
+    
+    return faces1 == faces2;
+}
+
+#endif // TEST_POINTS_H
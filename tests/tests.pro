@@ -0,0 +1,8 @@
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    dynamic_hull \
+    duplicate_removal \
+    batch_hull \
+    online_hull \
+    divide_conquer_hull